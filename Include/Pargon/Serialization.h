@@ -1,10 +1,21 @@
 #pragma once
 
+#include "Pargon/Serialization/BatchReader.h"
+#include "Pargon/Serialization/BatchWriter.h"
 #include "Pargon/Serialization/BlueprintReader.h"
 #include "Pargon/Serialization/BlueprintWriter.h"
 #include "Pargon/Serialization/BufferReader.h"
 #include "Pargon/Serialization/BufferWriter.h"
+#include "Pargon/Serialization/CharacterSet.h"
+#include "Pargon/Serialization/DeferredLog.h"
+#include "Pargon/Serialization/FormatCache.h"
+#include "Pargon/Serialization/LogReader.h"
+#include "Pargon/Serialization/LogWriter.h"
+#include "Pargon/Serialization/Pattern.h"
 #include "Pargon/Serialization/Serialization.h"
 #include "Pargon/Serialization/Serializer.h"
+#include "Pargon/Serialization/StaticFormat.h"
 #include "Pargon/Serialization/StringReader.h"
 #include "Pargon/Serialization/StringWriter.h"
+#include "Pargon/Serialization/WorkPool.h"
+#include "Pargon/Serialization/WriterPool.h"
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Pargon/Containers/Buffer.h"
+#include "Pargon/Serialization/BatchWriter.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/Serialization.h"
+
+namespace Pargon
+{
+	class BatchReader
+	{
+	public:
+		BatchReader(BufferView batch);
+		BatchReader(BufferView data, SequenceView<BatchEntry> index);
+
+		auto IsValid() const -> bool;
+		auto Count() const -> int;
+
+		auto GetView(int index) const -> BufferView;
+		auto GetReader(int index) const -> BufferReader;
+		template<typename T> auto Read(int index, T& item) const -> bool;
+
+	private:
+		BufferView _data;
+		BufferView _index;
+		int _count = 0;
+		bool _isEncoded = false;
+		bool _isValid = false;
+	};
+}
+
+inline
+auto Pargon::BatchReader::IsValid() const -> bool
+{
+	return _isValid;
+}
+
+inline
+auto Pargon::BatchReader::Count() const -> int
+{
+	return _count;
+}
+
+inline
+auto Pargon::BatchReader::GetReader(int index) const -> BufferReader
+{
+	return { GetView(index) };
+}
+
+template<typename T>
+auto Pargon::BatchReader::Read(int index, T& item) const -> bool
+{
+	auto reader = GetReader(index);
+	return reader.Read(item);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Pargon/Containers/Buffer.h"
+#include "Pargon/Containers/List.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Pargon/Serialization/Serialization.h"
+
+namespace Pargon
+{
+	struct BatchEntry
+	{
+		int Offset;
+		int Length;
+	};
+
+	class BatchWriter
+	{
+	public:
+		auto Count() const -> int;
+		auto GetIndex() const -> SequenceView<BatchEntry>;
+		auto GetBuffer() const -> BufferView;
+
+		template<typename T> auto Add(const T& item) -> bool;
+		template<typename SequenceType> auto AddRange(const SequenceType& items) -> bool;
+
+		auto Finish() -> BufferView;
+		auto ExtractBuffer() -> Buffer;
+		void Reset();
+
+	private:
+		BufferWriter _writer;
+		List<BatchEntry> _index;
+		bool _finished = false;
+	};
+}
+
+inline
+auto Pargon::BatchWriter::Count() const -> int
+{
+	return _index.Count();
+}
+
+inline
+auto Pargon::BatchWriter::GetIndex() const -> SequenceView<BatchEntry>
+{
+	return _index;
+}
+
+inline
+auto Pargon::BatchWriter::GetBuffer() const -> BufferView
+{
+	return _writer.GetBuffer();
+}
+
+inline
+auto Pargon::BatchWriter::ExtractBuffer() -> Buffer
+{
+	Finish();
+	return _writer.ExtractBuffer();
+}
+
+inline
+void Pargon::BatchWriter::Reset()
+{
+	_writer.Reset();
+	_index.Clear();
+	_finished = false;
+}
+
+template<typename T>
+auto Pargon::BatchWriter::Add(const T& item) -> bool
+{
+	// once Finish has written the trailer nothing more can be added until Reset
+
+	if (_finished)
+		return false;
+
+	// a bit packed item is padded out to a whole byte so the next item does not share its last byte
+
+	auto offset = _writer.Size();
+	_writer.Write(item);
+	_writer.Realign(false);
+	_index.Add({ offset, _writer.Size() - offset });
+	return true;
+}
+
+template<typename SequenceType>
+auto Pargon::BatchWriter::AddRange(const SequenceType& items) -> bool
+{
+	if (_finished)
+		return false;
+
+	for (auto& item : items)
+		Add(item);
+
+	return true;
+}
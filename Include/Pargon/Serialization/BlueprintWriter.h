@@ -18,6 +18,7 @@ namespace Pargon
 
 		auto GetBlueprint() const -> const Blueprint&;
 		auto ExtractBlueprint() -> Blueprint;
+		void Reset();
 
 		void MoveDown(int index);
 		void MoveDown(StringView child);
@@ -53,7 +54,7 @@ namespace Pargon
 
 		Blueprint _blueprint;
 		Blueprint* _current = std::addressof(_blueprint);
-		int _currentIndex;
+		int _currentIndex = 0;
 
 		void Write_(char character);
 		void Write_(wchar_t character);
@@ -115,6 +116,15 @@ auto Pargon::BlueprintWriter::ExtractBlueprint() -> Blueprint
 	return blueprint;
 }
 
+inline
+void Pargon::BlueprintWriter::Reset()
+{
+	_tree.Clear();
+	_blueprint.SetToInvalid();
+	_current = std::addressof(_blueprint);
+	_currentIndex = 0;
+}
+
 template<typename T>
 void Pargon::BlueprintWriter::Write(const T& item)
 {
@@ -4,7 +4,10 @@
 #include "Pargon/Containers/Map.h"
 #include "Pargon/Containers/String.h"
 #include "Pargon/Serialization/Serialization.h"
+#include "Pargon/Serialization/WorkPool.h"
 
+#include <algorithm>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -28,6 +31,7 @@ namespace Pargon
 		template<typename T> static constexpr auto CanRead() -> bool;
 
 		BufferReader(BufferView view);
+		void Rebind(BufferView view);
 
 		auto Endian() const -> Endian;
 		void SetEndian(Pargon::Endian endian);
@@ -56,6 +60,7 @@ namespace Pargon
 
 		template<typename T> auto Read() -> T;
 		template<typename T> auto Read(T& value) -> bool;
+		template<typename ItemType> auto ReadChunked(List<ItemType>& list, WorkPool& pool) -> bool;
 
 	private:
 		class Traits
@@ -187,6 +192,101 @@ auto Pargon::BufferReader::Read(T& item) -> bool
 	return !_hasFailed && Read_(item);
 }
 
+template<typename ItemType>
+auto Pargon::BufferReader::ReadChunked(List<ItemType>& list, WorkPool& pool) -> bool
+{
+	// reads the framed layout written by BufferWriter::WriteChunked
+
+	int frameSize, count, chunkSize, chunkCount;
+
+	if (_hasFailed || !Read_(frameSize))
+		return false;
+
+	auto frameStart = _index;
+
+	if (!Read_(count) || !Read_(chunkSize) || !Read_(chunkCount))
+		return false;
+
+	// the header is untrusted so nothing is allocated from it until it has been checked against the input
+
+	if (count < 0 || chunkSize < 1 || chunkCount != (static_cast<long long>(count) + chunkSize - 1) / chunkSize)
+	{
+		ReportError("invalid chunk header");
+		return false;
+	}
+
+	if ((static_cast<long long>(chunkCount) + 1) * static_cast<long long>(SerializationTraits::NormalizedSize<int>) > Remaining())
+	{
+		ReportError("chunk offset table is larger than the input");
+		return false;
+	}
+
+	auto offsets = std::make_unique<int[]>(chunkCount + 1);
+
+	for (auto i = 0; i <= chunkCount; i++)
+	{
+		if (!Read_(offsets[i]))
+			return false;
+
+		if (offsets[i] < (i == 0 ? 0 : offsets[i - 1]))
+		{
+			ReportError("invalid chunk offset table");
+			return false;
+		}
+	}
+
+	auto data = ReadBytes(offsets[chunkCount]);
+
+	if (_hasFailed)
+		return false;
+
+	if (_index - frameStart != frameSize)
+	{
+		ReportError("chunk frame size does not match its contents");
+		return false;
+	}
+
+	// every item takes at least one bit of chunk data
+
+	if (count > static_cast<long long>(offsets[chunkCount]) * 8)
+	{
+		ReportError("chunk item count is larger than the chunk data");
+		return false;
+	}
+
+	List<ItemType> placeholder;
+	placeholder.EnsureCount(count, {});
+
+	auto failed = std::make_unique<bool[]>(chunkCount);
+
+	pool.Run(chunkCount, [&](int chunk, int worker)
+	{
+		BufferReader reader({ data.begin() + offsets[chunk], offsets[chunk + 1] - offsets[chunk] });
+		reader.SetEndian(_endian);
+
+		auto begin = chunk * chunkSize;
+		auto end = std::min(begin + chunkSize, count);
+
+		for (auto i = begin; i < end && !reader.HasFailed(); i++)
+			reader.Read_(placeholder.Item(i));
+
+		reader.Realign();
+		failed[chunk] = reader.HasFailed() || !reader.AtEnd();
+	});
+
+	for (auto i = 0; i < chunkCount; i++)
+	{
+		if (failed[i])
+		{
+			ReportError("failed to read chunk");
+			return false;
+		}
+	}
+
+	list = std::move(placeholder);
+	return true;
+}
+
 template<typename ItemType, int N>
 auto Pargon::BufferReader::Read_(Array<ItemType, N>& array) -> bool
 {
@@ -2,7 +2,10 @@
 
 #include "Pargon/Containers/Buffer.h"
 #include "Pargon/Serialization/Serialization.h"
+#include "Pargon/Serialization/WorkPool.h"
 
+#include <algorithm>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -25,9 +28,11 @@ namespace Pargon
 
 		auto GetBuffer() const -> BufferView;
 		auto ExtractBuffer() -> Buffer;
+		void Reset();
 
 		void Align(size_t size);
 		void WriteBytes(BufferView data, bool correctEndian);
+		void OverwriteBytes(int index, BufferView data, bool correctEndian);
 
 		void WriteBit(bool bit);
 		void WriteBits(int count, long long bits);
@@ -35,6 +40,7 @@ namespace Pargon
 		void Realign(bool bit);
 
 		template<typename T> void Write(const T& value);
+		template<typename SequenceType> void WriteChunked(const SequenceType& sequence, WorkPool& pool, int chunkSize);
 
 	private:
 		friend class Serializer;
@@ -53,7 +59,7 @@ namespace Pargon
 			template<typename T> static constexpr bool CanWriteAsFunction = HasToBufferFunction<T, BufferWriter>::value;
 		};
 
-		Pargon::Endian _endian;
+		Pargon::Endian _endian = NativeEndian;
 		int _bitIndex = 7;
 		Buffer _buffer;
 
@@ -84,6 +90,7 @@ namespace Pargon
 		void WriteString(StringView string);
 		void WriteText(TextView string);
 		template<typename ItemType> void WriteSequence(SequenceView<ItemType> sequence);
+		template<typename ItemType> void WriteChunkedSequence(SequenceView<ItemType> sequence, WorkPool& pool, int chunkSize);
 
 		template<typename T> void Serialize(T&& value);
 		template<typename T> void Serialize(StringView name, T&& value);
@@ -139,12 +146,26 @@ auto Pargon::BufferWriter::ExtractBuffer() -> Buffer
 	return buffer;
 }
 
+inline
+void Pargon::BufferWriter::Reset()
+{
+	_buffer.Clear();
+	_bitIndex = 7;
+}
+
 template<typename T>
 void Pargon::BufferWriter::Write(const T& item)
 {
 	Write_(item);
 }
 
+template<typename SequenceType>
+void Pargon::BufferWriter::WriteChunked(const SequenceType& sequence, WorkPool& pool, int chunkSize)
+{
+	static_assert(SerializationTraits::CanViewAsSequence<SequenceType>, "SequenceType cannot be viewed as a Sequence");
+	WriteChunkedSequence<SerializationTraits::SequenceType<SequenceType>>(sequence, pool, chunkSize);
+}
+
 template<typename KeyType, typename ItemType>
 void Pargon::BufferWriter::Write_(const Map<KeyType, ItemType>& map)
 {
@@ -204,6 +225,78 @@ void Pargon::BufferWriter::WriteSequence(SequenceView<ItemType> sequence)
 		Write_(item);
 }
 
+template<typename ItemType>
+void Pargon::BufferWriter::WriteChunkedSequence(SequenceView<ItemType> sequence, WorkPool& pool, int chunkSize)
+{
+	// layout
+	// frame size in bytes, excluding the frame size itself
+	// item count, items per chunk, chunk count
+	// chunk count + 1 offsets into the chunk data, the last being the size of the chunk data
+	// chunk data in order
+
+	struct ChunkLocation
+	{
+		int Worker;
+		int Offset;
+		int Size;
+	};
+
+	chunkSize = std::max(chunkSize, 1);
+
+	auto count = sequence.Count();
+	auto chunkCount = (count + chunkSize - 1) / chunkSize;
+	auto workers = std::make_unique<BufferWriter[]>(pool.WorkerCount());
+	auto locations = std::make_unique<ChunkLocation[]>(chunkCount);
+
+	for (auto i = 0; i < pool.WorkerCount(); i++)
+		workers[i].SetEndian(_endian);
+
+	pool.Run(chunkCount, [&](int chunk, int worker)
+	{
+		// each chunk starts on a byte boundary so that bits written by the previous chunk on this worker don't change
+		// its bytes - the reader decodes every chunk with a fresh BufferReader
+
+		auto& writer = workers[worker];
+		writer.Realign(false);
+
+		auto begin = chunk * chunkSize;
+		auto end = std::min(begin + chunkSize, count);
+		auto offset = writer.Size();
+
+		for (auto i = begin; i < end; i++)
+			writer.Write_(*(sequence.begin() + i));
+
+		locations[chunk] = { worker, offset, writer.Size() - offset };
+	});
+
+	auto dataSize = 0;
+	for (auto i = 0; i < chunkCount; i++)
+		dataSize += locations[i].Size;
+
+	auto headerSize = static_cast<int>(SerializationTraits::NormalizedSize<int>) * (chunkCount + 4);
+
+	Write_(headerSize + dataSize);
+	Write_(count);
+	Write_(chunkSize);
+	Write_(chunkCount);
+
+	auto offset = 0;
+	for (auto i = 0; i < chunkCount; i++)
+	{
+		Write_(offset);
+		offset += locations[i].Size;
+	}
+
+	Write_(offset);
+
+	for (auto i = 0; i < chunkCount; i++)
+	{
+		auto& location = locations[i];
+		auto buffer = workers[location.Worker].GetBuffer();
+		WriteBytes({ buffer.begin() + location.Offset, location.Size }, false);
+	}
+}
+
 template<typename T>
 void Pargon::BufferWriter::Serialize(T&& value)
 {
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Pargon/Containers/String.h"
+
+#include <cstdint>
+
+namespace Pargon
+{
+	class CharacterSet
+	{
+	public:
+		constexpr CharacterSet() = default;
+		constexpr explicit CharacterSet(const char* characters);
+		CharacterSet(StringView characters, bool ignoreCase);
+
+		constexpr void Add(char character);
+		constexpr auto Contains(char character) const -> bool;
+
+	private:
+		friend auto IndexOfAny(StringView text, const CharacterSet& set) -> int;
+		friend auto IndexOfAnyOther(StringView text, const CharacterSet& set) -> int;
+		friend auto LastIndexOfAny(StringView text, const CharacterSet& set) -> int;
+		friend auto LastIndexOfAnyOther(StringView text, const CharacterSet& set) -> int;
+
+		// the 256 bits are indexed by the low nibble of a character then its high nibble so that both halves can be
+		// looked up 16 or 32 characters at a time with a byte shuffle - _low holds high nibbles 0-7 and _high 8-15
+
+		uint8_t _low[16] = {};
+		uint8_t _high[16] = {};
+	};
+
+	auto IndexOfAny(StringView text, const CharacterSet& set) -> int;
+	auto IndexOfAnyOther(StringView text, const CharacterSet& set) -> int;
+	auto LastIndexOfAny(StringView text, const CharacterSet& set) -> int;
+	auto LastIndexOfAnyOther(StringView text, const CharacterSet& set) -> int;
+}
+
+constexpr
+Pargon::CharacterSet::CharacterSet(const char* characters)
+{
+	for (; *characters != '\0'; characters++)
+		Add(*characters);
+}
+
+constexpr
+void Pargon::CharacterSet::Add(char character)
+{
+	auto byte = static_cast<unsigned char>(character);
+	auto& row = (byte & 0x80) ? _high[byte & 0x0F] : _low[byte & 0x0F];
+	row = static_cast<uint8_t>(row | (1 << ((byte >> 4) & 0x07)));
+}
+
+constexpr
+auto Pargon::CharacterSet::Contains(char character) const -> bool
+{
+	auto byte = static_cast<unsigned char>(character);
+	auto row = (byte & 0x80) ? _high[byte & 0x0F] : _low[byte & 0x0F];
+	return ((row >> ((byte >> 4) & 0x07)) & 1) != 0;
+}
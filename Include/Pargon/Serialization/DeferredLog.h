@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Pargon/Serialization/FormatCache.h"
+#include "Pargon/Serialization/StaticFormat.h"
+#include "Pargon/Serialization/StringWriter.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+namespace Pargon
+{
+	class DeferredLog
+	{
+	public:
+		using Output = std::function<void(StringView line)>;
+
+		DeferredLog(Output output, int capacity);
+		~DeferredLog();
+
+		DeferredLog(const DeferredLog&) = delete;
+		auto operator=(const DeferredLog&) -> DeferredLog& = delete;
+
+		auto Dropped() const -> long long;
+
+		template<typename TextType, typename... Ts> auto Log(StaticFormat<TextType> format, const Ts&... inputs) -> bool;
+		template<typename... Ts> auto Log(const StringFormat& format, const Ts&... inputs) -> bool;
+		template<typename... Ts> auto Log(StringView format, const Ts&... inputs) -> bool;
+		void Flush();
+
+	private:
+		using Decoder = void(*)(const void* format, BufferReader& reader, StringWriter& writer);
+
+		struct Header
+		{
+			int Size;
+			Decoder Decode;
+			const void* Format;
+		};
+
+		template<typename T> static constexpr bool IsString = SerializationTraits::CanViewAsString<std::decay_t<T>> || std::is_same<std::decay_t<T>, const char*>::value || std::is_same<std::decay_t<T>, char*>::value;
+		template<typename T> using Argument = std::conditional_t<IsString<T>, String, std::decay_t<T>>;
+
+		Output _output;
+		std::unique_ptr<uint8_t[]> _ring;
+		std::unique_ptr<uint8_t[]> _record;
+		int _capacity;
+
+		std::atomic<long long> _head;
+		std::atomic<long long> _tail;
+		std::atomic<long long> _dropped;
+		std::atomic<bool> _sleeping;
+
+		BufferWriter _arguments;
+		StringWriter _line;
+
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _drained;
+		bool _stopping = false;
+		std::thread _thread;
+
+		template<typename T> void Encode(const T& input);
+		auto Commit(Decoder decode, const void* format) -> bool;
+
+		void CopyIn(long long position, const void* data, int size);
+		void CopyOut(long long position, void* data, int size) const;
+		void Work();
+
+		template<typename TextType, typename... Ts> static void DecodeStatic(const void* format, BufferReader& reader, StringWriter& writer);
+		template<typename... Ts> static void DecodeParsed(const void* format, BufferReader& reader, StringWriter& writer);
+		template<typename... Ts> static void DecodeText(const void* format, BufferReader& reader, StringWriter& writer);
+	};
+}
+
+inline
+auto Pargon::DeferredLog::Dropped() const -> long long
+{
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+template<typename TextType, typename... Ts>
+auto Pargon::DeferredLog::Log(StaticFormat<TextType> format, const Ts&... inputs) -> bool
+{
+	_arguments.Reset();
+	(Encode(inputs), ...);
+
+	return Commit(&DecodeStatic<TextType, Argument<Ts>...>, nullptr);
+}
+
+template<typename... Ts>
+auto Pargon::DeferredLog::Log(const StringFormat& format, const Ts&... inputs) -> bool
+{
+	// the background thread uses the format directly so it has to outlive the records that refer to it - the entries
+	// returned by FormatCache::Find are never freed
+
+	_arguments.Reset();
+	(Encode(inputs), ...);
+
+	return Commit(&DecodeParsed<Argument<Ts>...>, std::addressof(format));
+}
+
+template<typename... Ts>
+auto Pargon::DeferredLog::Log(StringView format, const Ts&... inputs) -> bool
+{
+	// the format text is copied into the record ahead of the inputs and parsed by the background thread
+
+	_arguments.Reset();
+	_arguments.Write(format);
+	(Encode(inputs), ...);
+
+	return Commit(&DecodeText<Argument<Ts>...>, nullptr);
+}
+
+template<typename T>
+void Pargon::DeferredLog::Encode(const T& input)
+{
+	if constexpr (IsString<T>)
+		_arguments.Write(StringView(input));
+	else
+		_arguments.Write(input);
+}
+
+template<typename TextType, typename... Ts>
+void Pargon::DeferredLog::DecodeStatic(const void* format, BufferReader& reader, StringWriter& writer)
+{
+	std::tuple<Ts...> arguments;
+
+	std::apply([&](auto&... inputs)
+	{
+		(reader.Read(inputs), ...);
+		writer.Format(StaticFormat<TextType>{}, inputs...);
+	}, arguments);
+}
+
+template<typename... Ts>
+void Pargon::DeferredLog::DecodeParsed(const void* format, BufferReader& reader, StringWriter& writer)
+{
+	std::tuple<Ts...> arguments;
+
+	std::apply([&](auto&... inputs)
+	{
+		(reader.Read(inputs), ...);
+		writer.Format(*static_cast<const StringFormat*>(format), inputs...);
+	}, arguments);
+}
+
+template<typename... Ts>
+void Pargon::DeferredLog::DecodeText(const void* format, BufferReader& reader, StringWriter& writer)
+{
+	String text;
+	reader.Read(text);
+
+	std::tuple<Ts...> arguments;
+
+	std::apply([&](auto&... inputs)
+	{
+		(reader.Read(inputs), ...);
+		writer.Format(StringView(text), inputs...);
+	}, arguments);
+}
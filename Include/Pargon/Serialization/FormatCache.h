@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Pargon/Serialization/Serialization.h"
+
+namespace Pargon
+{
+	class StringView;
+
+	// caching is opt in - Format and Parse never consult the cache themselves since every distinct pointer takes an
+	// entry for the rest of the program, so only formats with stable storage, such as localization tables, should be
+	// passed to Find and the result passed on to Format or Parse
+
+	class FormatCache
+	{
+	public:
+		static constexpr int Capacity = 1024;
+
+		static auto Find(StringView format) -> const StringFormat*;
+
+		static auto Hits() -> long long;
+		static auto Misses() -> long long;
+		static auto Count() -> int;
+	};
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Pargon/Containers/Buffer.h"
+#include "Pargon/Containers/List.h"
+#include "Pargon/Serialization/BufferReader.h"
+
+namespace Pargon
+{
+	class LogReader
+	{
+	public:
+		LogReader(BufferView log);
+
+		auto RecordNumber() const -> long long;
+		auto SkippedBytes() const -> int;
+
+		auto ReadBytes(BufferView& record) -> bool;
+		template<typename T> auto Read(T& record) -> bool;
+
+		void BuildIndex();
+		auto Seek(long long record) -> bool;
+
+	private:
+		struct Block
+		{
+			int Offset;
+			int Size;
+			int RecordCount;
+			long long FirstRecord;
+			BufferView Payload;
+		};
+
+		struct IndexEntry
+		{
+			long long FirstRecord;
+			int Offset;
+		};
+
+		const uint8_t* _data;
+		int _length;
+
+		int _nextBlock = 0;
+		int _skipped = 0;
+
+		BufferView _payload;
+		int _payloadIndex = 0;
+		int _recordsLeft = 0;
+		long long _recordNumber = 0;
+
+		List<IndexEntry> _index;
+
+		auto ParseBlock(int offset, Block& block) const -> bool;
+		auto FindBlock(int offset, Block& block, int& skipped) const -> bool;
+		void EnterBlock(const Block& block);
+	};
+}
+
+inline
+auto Pargon::LogReader::RecordNumber() const -> long long
+{
+	return _recordNumber;
+}
+
+inline
+auto Pargon::LogReader::SkippedBytes() const -> int
+{
+	return _skipped;
+}
+
+template<typename T>
+auto Pargon::LogReader::Read(T& record) -> bool
+{
+	BufferView bytes;
+	if (!ReadBytes(bytes))
+		return false;
+
+	BufferReader reader(bytes);
+	return reader.Read(record);
+}
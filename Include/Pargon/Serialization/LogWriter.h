@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Pargon/Containers/Buffer.h"
+#include "Pargon/Serialization/BufferWriter.h"
+
+#include <functional>
+
+namespace Pargon
+{
+	class LogWriter
+	{
+	public:
+		using Output = std::function<void(BufferView block)>;
+
+		LogWriter(Output output, int blockSize);
+		~LogWriter();
+
+		LogWriter(const LogWriter&) = delete;
+		auto operator=(const LogWriter&) -> LogWriter& = delete;
+
+		auto RecordCount() const -> long long;
+
+		void AppendBytes(BufferView record);
+		template<typename T> void Append(const T& record);
+		void Flush();
+
+	private:
+		Output _output;
+		int _blockSize;
+
+		BufferWriter _block;
+		int _blockRecords = 0;
+		long long _recordCount = 0;
+
+		auto BeginRecord() -> int;
+		void EndRecord(int start);
+	};
+}
+
+inline
+auto Pargon::LogWriter::RecordCount() const -> long long
+{
+	return _recordCount;
+}
+
+template<typename T>
+void Pargon::LogWriter::Append(const T& record)
+{
+	auto start = BeginRecord();
+	_block.Write(record);
+	EndRecord(start);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Pargon/Containers/String.h"
+
+#include <memory>
+
+namespace Pargon
+{
+	class Pattern
+	{
+	public:
+		static constexpr int CacheCapacity = 64;
+
+		// returns a pattern compiled on an earlier call with the same text if one is still in the calling thread's
+		// cache - the reference stays valid until CacheCapacity other patterns have been compiled on the thread
+
+		static auto Cached(StringView pattern, bool ignoreCase) -> const Pattern&;
+
+		Pattern(StringView pattern, bool ignoreCase);
+
+		auto Text() const -> StringView;
+		auto IgnoreCase() const -> bool;
+		auto IsLiteral() const -> bool;
+
+		auto Search(StringView text) const -> int;
+		auto Match(StringView text) const -> int;
+
+	private:
+		// the compiled regex is kept out of the header so including Pattern does not pull in <regex>
+
+		struct Expression;
+
+		String _text;
+		bool _ignoreCase;
+		bool _isLiteral;
+		std::shared_ptr<const Expression> _expression;
+	};
+}
+
+inline
+auto Pargon::Pattern::Text() const -> StringView
+{
+	return _text;
+}
+
+inline
+auto Pargon::Pattern::IgnoreCase() const -> bool
+{
+	return _ignoreCase;
+}
+
+inline
+auto Pargon::Pattern::IsLiteral() const -> bool
+{
+	return _isLiteral;
+}
@@ -126,6 +126,29 @@ namespace Pargon
 		template<typename T> static constexpr bool IsFormatArgument = FormatArgumentTest<T>::value;
 	};
 
+	struct NumberFormat
+	{
+		// [[fill]align][sign][0][width][.precision][type]
+		// align -> '<' left, '>' right (default), '^' center, '=' padding between the sign and the digits
+		// sign -> '-' only negative (default), '+' always, ' ' a space for positive
+		// type -> 'd' decimal, 'x' or 'X' hex, 'f' fixed, 'e' scientific, 'g' general - '#' is the same as 'X'
+
+		enum class AlignmentType : char { Left, Right, Center, AfterSign };
+		enum class NotationType : char { Default, Decimal, Hexadecimal, UpperHexadecimal, Fixed, Scientific, General };
+
+		static constexpr int MaximumWidth = 4096;
+		static constexpr int MaximumPrecision = 64;
+
+		char Fill = ' ';
+		char Sign = '-';
+		AlignmentType Alignment = AlignmentType::Right;
+		NotationType Notation = NotationType::Default;
+		int Width = 0;
+		int Precision = -1;
+	};
+
+	constexpr auto ParseNumberFormat(const char* specification, int length) -> NumberFormat;
+
 	struct FormatToken
 	{
 		static constexpr int NoParameter = -1;
@@ -134,6 +157,7 @@ namespace Pargon
 		int ParameterIndex;
 		StringView ParameterName;
 		StringView Specification;
+		NumberFormat Number;
 	};
 
 	struct StringFormat
@@ -147,7 +171,11 @@ namespace Pargon
 	};
 
 	auto ParseFormatString(StringView format) -> StringFormat;
+	auto ReadFormatToken(StringView format, int& cursor, int& nextIndex, FormatToken& token) -> bool;
 	auto ParseFormatText(TextView format) -> TextFormat;
+
+	auto BindFormat(StringFormat& format, SequenceView<StringView> names) -> bool;
+	auto BindFormat(TextFormat& format, SequenceView<StringView> names) -> bool;
 }
 
 template<typename T>
@@ -155,3 +183,93 @@ auto Pargon::NamedArgument(StringView Name, T& value) -> FormatArgument<T>
 {
 	return { name, value };
 }
+
+constexpr
+auto Pargon::ParseNumberFormat(const char* specification, int length) -> NumberFormat
+{
+	// a specification that does not match the grammar, such as the flags used by the other types, gives the default
+
+	using AlignmentType = NumberFormat::AlignmentType;
+	using NotationType = NumberFormat::NotationType;
+
+	auto getAlignment = [](char character, AlignmentType& alignment)
+	{
+		switch (character)
+		{
+			case '<': alignment = AlignmentType::Left; return true;
+			case '>': alignment = AlignmentType::Right; return true;
+			case '^': alignment = AlignmentType::Center; return true;
+			case '=': alignment = AlignmentType::AfterSign; return true;
+			default: return false;
+		}
+	};
+
+	NumberFormat format;
+	auto cursor = 0;
+	auto aligned = false;
+
+	if (length >= 2 && getAlignment(specification[1], format.Alignment))
+	{
+		format.Fill = specification[0];
+		aligned = true;
+		cursor = 2;
+	}
+	else if (length >= 1 && getAlignment(specification[0], format.Alignment))
+	{
+		aligned = true;
+		cursor = 1;
+	}
+
+	if (cursor < length && (specification[cursor] == '-' || specification[cursor] == '+' || specification[cursor] == ' '))
+		format.Sign = specification[cursor++];
+
+	if (cursor < length && specification[cursor] == '0' && !aligned)
+	{
+		format.Fill = '0';
+		format.Alignment = AlignmentType::AfterSign;
+		cursor++;
+	}
+
+	for (; cursor < length && specification[cursor] >= '0' && specification[cursor] <= '9'; cursor++)
+	{
+		if (format.Width <= NumberFormat::MaximumWidth)
+			format.Width = format.Width * 10 + (specification[cursor] - '0');
+	}
+
+	if (format.Width > NumberFormat::MaximumWidth)
+		format.Width = NumberFormat::MaximumWidth;
+
+	if (cursor < length && specification[cursor] == '.')
+	{
+		format.Precision = 0;
+
+		for (cursor++; cursor < length && specification[cursor] >= '0' && specification[cursor] <= '9'; cursor++)
+		{
+			if (format.Precision <= NumberFormat::MaximumPrecision)
+				format.Precision = format.Precision * 10 + (specification[cursor] - '0');
+		}
+
+		if (format.Precision > NumberFormat::MaximumPrecision)
+			format.Precision = NumberFormat::MaximumPrecision;
+	}
+
+	if (cursor < length)
+	{
+		switch (specification[cursor++])
+		{
+			case 'd': format.Notation = NotationType::Decimal; break;
+			case 'x': format.Notation = NotationType::Hexadecimal; break;
+			case 'X': format.Notation = NotationType::UpperHexadecimal; break;
+			case '#': format.Notation = NotationType::UpperHexadecimal; break;
+			case 'f': format.Notation = NotationType::Fixed; break;
+			case 'e': format.Notation = NotationType::Scientific; break;
+			case 'g': format.Notation = NotationType::General; break;
+			default: return {};
+		}
+	}
+
+	if (cursor != length)
+		return {};
+
+	return format;
+}
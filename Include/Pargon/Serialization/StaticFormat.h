@@ -0,0 +1,208 @@
+#pragma once
+
+#include "Pargon/Serialization/Serialization.h"
+
+// wraps a string literal in a type so that it can be parsed at compile time and passed to StringWriter::Format or
+// FormatString without any runtime parsing
+
+#define PARGON_STATIC_FORMAT(format) [] { struct StaticFormatText { static constexpr auto Text() -> const char* { return format; } }; return Pargon::StaticFormat<StaticFormatText>{}; }()
+
+namespace Pargon
+{
+	struct StaticFormatToken
+	{
+		int ParameterIndex;
+		int NameStart;
+		int NameLength;
+		int SpecificationStart;
+		int SpecificationLength;
+		NumberFormat Number;
+	};
+
+	template<int N>
+	struct StaticStringFormat
+	{
+		StaticFormatToken Tokens[N > 0 ? N : 1];
+		int ParameterCount;
+		unsigned long long UsedParameters;
+		bool HasNamedParameters;
+		bool IsValid;
+	};
+
+	class StaticFormatParser
+	{
+	public:
+		static constexpr auto Length(const char* format) -> int;
+		static constexpr auto Count(const char* format, int length) -> int;
+		template<int N> static constexpr auto Parse(const char* format, int length) -> StaticStringFormat<N>;
+
+	private:
+		template<typename FormatType> static constexpr auto Parse(const char* format, int length, FormatType* tokens) -> int;
+		template<typename FormatType> static constexpr void Add(FormatType* tokens, const char* format, int count, int index, int nameStart, int nameLength, int specificationStart, int specificationLength);
+
+		static constexpr auto Find(const char* format, int begin, int end, char character) -> int;
+		static constexpr auto FindSpecificationEnd(const char* format, int begin, int end) -> int;
+		static constexpr auto ParseInt(const char* format, int begin, int end) -> int;
+	};
+
+	template<typename TextType>
+	struct StaticFormat
+	{
+		static constexpr const char* Text = TextType::Text();
+		static constexpr int Length = StaticFormatParser::Length(Text);
+		static constexpr int Count = StaticFormatParser::Count(Text, Length);
+		static constexpr StaticStringFormat<Count> Format = StaticFormatParser::Parse<Count>(Text, Length);
+
+		static_assert(Format.IsValid, "format string has an unterminated parameter");
+	};
+}
+
+constexpr
+auto Pargon::StaticFormatParser::Length(const char* format) -> int
+{
+	auto length = 0;
+
+	while (format[length] != '\0')
+		length++;
+
+	return length;
+}
+
+constexpr
+auto Pargon::StaticFormatParser::Count(const char* format, int length) -> int
+{
+	return Parse<StaticStringFormat<0>>(format, length, nullptr);
+}
+
+template<int N>
+constexpr auto Pargon::StaticFormatParser::Parse(const char* format, int length) -> StaticStringFormat<N>
+{
+	StaticStringFormat<N> tokens = {};
+
+	if constexpr (N >= 0)
+		tokens.IsValid = Parse(format, length, &tokens) == N;
+
+	return tokens;
+}
+
+template<typename FormatType>
+constexpr auto Pargon::StaticFormatParser::Parse(const char* format, int length, FormatType* tokens) -> int
+{
+	// mirrors ParseFormatString - returns -1 if a parameter is not terminated
+
+	auto count = 0;
+	auto nextIndex = 0;
+	auto cursor = 0;
+
+	while (cursor != length)
+	{
+		auto open = Find(format, cursor, length, '{');
+
+		if (cursor != open)
+		{
+			Add(tokens, format, count++, FormatToken::NoParameter, 0, 0, cursor, open - cursor);
+			cursor = open;
+		}
+
+		if (open < length - 1 && format[open + 1] == '{')
+		{
+			Add(tokens, format, count++, FormatToken::NoParameter, 0, 0, cursor, 1);
+			cursor += 2;
+		}
+		else if (open != length)
+		{
+			cursor = open + 1;
+
+			auto brace = Find(format, cursor, length, '}');
+			auto pipe = Find(format, cursor, length, '|');
+			auto id = pipe < brace ? pipe : brace;
+
+			if (id == length)
+				return -1;
+
+			auto specification = format[id] == '}' ? id : FindSpecificationEnd(format, id + 1, length);
+
+			if (specification == length)
+				return -1;
+
+			auto index = FormatToken::NamedParameter;
+
+			if (id == cursor)
+				index = nextIndex++;
+			else if (format[cursor] == '-')
+				index = FormatToken::NoParameter;
+			else if (format[cursor] >= '0' && format[cursor] <= '9')
+				index = ParseInt(format, cursor, id);
+
+			if (format[id] == '|')
+				Add(tokens, format, count++, index, cursor, id - cursor, id + 1, specification - id - 1);
+			else
+				Add(tokens, format, count++, index, cursor, id - cursor, id, 0);
+
+			cursor = specification + 1;
+		}
+	}
+
+	return count;
+}
+
+template<typename FormatType>
+constexpr void Pargon::StaticFormatParser::Add(FormatType* tokens, const char* format, int count, int index, int nameStart, int nameLength, int specificationStart, int specificationLength)
+{
+	if (tokens == nullptr)
+		return;
+
+	auto number = index == FormatToken::NoParameter ? NumberFormat{} : ParseNumberFormat(format + specificationStart, specificationLength);
+	tokens->Tokens[count] = { index, nameStart, nameLength, specificationStart, specificationLength, number };
+
+	if (index == FormatToken::NamedParameter)
+		tokens->HasNamedParameters = true;
+	else if (index >= 0)
+	{
+		if (index >= tokens->ParameterCount)
+			tokens->ParameterCount = index + 1;
+
+		if (index < 64)
+			tokens->UsedParameters |= 1ull << index;
+	}
+}
+
+constexpr
+auto Pargon::StaticFormatParser::Find(const char* format, int begin, int end, char character) -> int
+{
+	while (begin < end && format[begin] != character)
+		begin++;
+
+	return begin;
+}
+
+constexpr
+auto Pargon::StaticFormatParser::FindSpecificationEnd(const char* format, int begin, int end) -> int
+{
+	auto braces = 0;
+
+	while (begin < end)
+	{
+		if (format[begin] == '{') ++braces;
+		else if (format[begin] == '}') --braces;
+
+		if (braces < 0) break;
+		else begin++;
+	}
+
+	return begin;
+}
+
+constexpr
+auto Pargon::StaticFormatParser::ParseInt(const char* format, int begin, int end) -> int
+{
+	auto value = 0;
+
+	for (auto cursor = begin; cursor < end; cursor++)
+	{
+		value *= 10;
+		value += format[cursor] - '0';
+	}
+
+	return value;
+}
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/CharacterSet.h"
+#include "Pargon/Serialization/Pattern.h"
 #include "Pargon/Serialization/Serialization.h"
 #include "Pargon/Serialization/StringWriter.h"
 
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -28,6 +31,7 @@ namespace Pargon
 		template<typename T> static constexpr auto CanRead() -> bool;
 
 		StringReader(StringView text);
+		void Rebind(StringView text);
 
 		auto Index() const -> int;
 		auto Remaining() const -> int;
@@ -35,6 +39,7 @@ namespace Pargon
 
 		auto HasFailed() const -> bool;
 		void ReportError(StringView message);
+		void GetLocation(int index, int& line, int& column) const;
 
 		auto ViewTo(int count) const -> StringView;
 		auto ViewNext() const -> char;
@@ -53,26 +58,34 @@ namespace Pargon
 		auto AdvanceTo(StringView string, bool ignoreCase) -> int;
 		auto AdvanceToWhitespace() -> int;
 		auto AdvanceToAny(StringView characters, bool ignoreCase) -> int;
+		auto AdvanceToAny(const CharacterSet& characters) -> int;
 		auto AdvanceToExpression(StringView pattern, bool ignoreCase) -> int;
+		auto AdvanceToExpression(const Pattern& pattern) -> int;
 
 		auto AdvancePast(StringView string, bool ignoreCase) -> int;
 		auto AdvancePastWhitespace() -> int;
 		auto AdvancePastAny(StringView characters, bool ignoreCase) -> int;
+		auto AdvancePastAny(const CharacterSet& characters) -> int;
 		auto AdvancePastExpression(StringView pattern, bool ignoreCase) -> int;
+		auto AdvancePastExpression(const Pattern& pattern) -> int;
 
 		auto RetreatTo(StringView string, bool ignoreCase) -> int;
 		auto RetreatToWhitespace() -> int;
 		auto RetreatToAny(StringView characters, bool ignoreCase) -> int;
+		auto RetreatToAny(const CharacterSet& characters) -> int;
 		auto RetreatToExpression(StringView pattern, bool ignoreCase) -> int;
+		auto RetreatToExpression(const Pattern& pattern) -> int;
 
 		auto RetreatPast(StringView string, bool ignoreCase) -> int;
 		auto RetreatPastWhitespace() -> int;
 		auto RetreatPastAny(StringView characters, bool ignoreCase) -> int;
+		auto RetreatPastAny(const CharacterSet& characters) -> int;
 		auto RetreatPastExpression(StringView pattern, bool ignoreCase) -> int;
+		auto RetreatPastExpression(const Pattern& pattern) -> int;
 
 		template<typename T> auto Read(T& value, StringView format) -> bool;
 		template<typename... Ts> auto Parse(StringView format, Ts&... inputs) -> bool;
-		template<typename... Ts> auto Parse(StringFormat format, Ts&... inputs) -> bool;
+		template<typename... Ts> auto Parse(const StringFormat& format, Ts&... inputs) -> bool;
 
 	private:
 		friend class Serializer;
@@ -96,6 +109,9 @@ namespace Pargon
 		bool _hasFailed = false;
 		List<Error> _errors;
 
+		mutable List<int> _newlines;
+		mutable int _newlinesEnd = 0;
+
 		void Read_(char& character, StringView format);
 		void Read_(wchar_t& character, StringView format);
 		void Read_(char16_t& character, StringView format);
@@ -155,25 +171,21 @@ namespace Pargon
 			}
 		}
 
-		template<int N>
-		static void ReadIndexedParameter(StringReader& reader, const FormatToken& token)
+		template<typename U>
+		static void ReadParameter(StringReader& reader, const FormatToken& token, void* parameter)
 		{
-			reader.ReportError(FormatString("no parameter with index {}", token.ParameterIndex));
-		}
+			constexpr auto isFormatArgument = SerializationTraits::IsFormatArgument<U>;
 
-		template<int N, typename U, typename... Us>
-		static void ReadIndexedParameter(StringReader& reader, const FormatToken& token, U& parameter, Us&... parameters)
-		{
-			if (token.ParameterIndex == N)
-				reader.Read(parameter, token.Specification);
+			if constexpr (isFormatArgument)
+				reader.Read(static_cast<U*>(parameter)->Value, token.Specification);
 			else
-				ReadIndexedParameter<N + 1>(reader, token, parameters...);
+				reader.Read(*static_cast<U*>(parameter), token.Specification);
 		}
 	};
 
 	template<typename T> auto ReadFromString(StringView string) -> T;
 	template<typename... Ts> auto ParseString(StringView format, Ts&... inputs) -> bool;
-	template<typename... Ts> auto ParseString(StringFormat format, Ts&... inputs) -> bool;
+	template<typename... Ts> auto ParseString(const StringFormat& format, Ts&... inputs) -> bool;
 }
 
 template<typename T>
@@ -228,10 +240,15 @@ auto Pargon::StringReader::Parse(StringView format, Ts&... inputs) -> bool
 }
 
 template<typename... Ts>
-auto Pargon::StringReader::Parse(StringFormat format, Ts&... inputs) -> bool
+auto Pargon::StringReader::Parse(const StringFormat& format, Ts&... inputs) -> bool
 {
 	auto errors = _errors.Count();
 
+	using ParameterReader = void(*)(StringReader&, const FormatToken&, void*);
+
+	static constexpr ParameterReader readers[] = { &ReadParameter<Ts>..., nullptr };
+	void* parameters[] = { std::addressof(inputs)..., nullptr };
+
 	StringView temporary;
 
 	for (auto& token : format.Tokens)
@@ -240,8 +257,10 @@ auto Pargon::StringReader::Parse(StringFormat format, Ts&... inputs) -> bool
 			Read(temporary, token.Specification);
 		else if (token.ParameterIndex == FormatToken::NamedParameter)
 			ReadNamedParameter(*this, token, inputs...);
+		else if (token.ParameterIndex < static_cast<int>(sizeof...(Ts)))
+			readers[token.ParameterIndex](*this, token, parameters[token.ParameterIndex]);
 		else
-			ReadIndexedParameter<0>(*this, token, inputs...);
+			ReportError(FormatString("no parameter with index {}", token.ParameterIndex));
 	}
 
 	return errors == _errors.Count();
@@ -488,7 +507,7 @@ auto Pargon::ParseString(StringView format, Ts&... inputs) -> bool
 }
 
 template<typename... Ts>
-auto Pargon::ParseString(StringFormat format, Ts&... inputs) -> bool
+auto Pargon::ParseString(const StringFormat& format, Ts&... inputs) -> bool
 {
 	StringReader reader;
 	reader.Parse(format, inputs...);
@@ -1,7 +1,16 @@
 #pragma once
 
+#include "Pargon/Containers/List.h"
 #include "Pargon/Containers/String.h"
 #include "Pargon/Serialization/Serialization.h"
+#include "Pargon/Serialization/StaticFormat.h"
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace Pargon
 {
@@ -17,13 +26,57 @@ namespace Pargon
 	public:
 		template<typename T> static constexpr auto CanWrite() -> bool;
 
+		using FlushFunction = std::function<bool(StringView characters)>;
+
+		StringWriter() = default;
+		StringWriter(char* buffer, int capacity);
+		StringWriter(char* buffer, int capacity, bool overflowToHeap);
+		StringWriter(char* buffer, int capacity, FlushFunction flush);
+		StringWriter(int threshold, FlushFunction flush);
+		explicit StringWriter(int chunkSize);
+		~StringWriter();
+
+		StringWriter(const StringWriter&) = delete;
+		StringWriter(StringWriter&& other);
+		auto operator=(const StringWriter&) -> StringWriter& = delete;
+		auto operator=(StringWriter&& other) -> StringWriter&;
+
 		auto GetString() const -> StringView;
 		auto ExtractString() -> String;
+		void Reset();
+
+		auto RequiredSize() const -> int;
+		auto IsTruncated() const -> bool;
+
+		auto ChunkCount() const -> int;
+		auto GetChunk(int index) const -> StringView;
+
+		void Flush();
+		auto FlushedSize() const -> long long;
+		auto HasFailed() const -> bool;
+
+		auto Reserve(int count) -> char*;
+		void Commit(int count);
 
 		void Write(StringView string);
 		template<typename T> void Write(const T& value, StringView format);
 		template<typename... Ts> void Format(StringView format, const Ts&... inputs);
-		template<typename... Ts> void Format(StringFormat format, const Ts&... inputs);
+		template<typename... Ts> void Format(const StringFormat& format, const Ts&... inputs);
+		template<typename TextType, typename... Ts> void Format(StaticFormat<TextType> format, const Ts&... inputs);
+
+		void WriteNumber(signed char number, const NumberFormat& format);
+		void WriteNumber(short number, const NumberFormat& format);
+		void WriteNumber(int number, const NumberFormat& format);
+		void WriteNumber(long number, const NumberFormat& format);
+		void WriteNumber(long long number, const NumberFormat& format);
+		void WriteNumber(unsigned char number, const NumberFormat& format);
+		void WriteNumber(unsigned short number, const NumberFormat& format);
+		void WriteNumber(unsigned int number, const NumberFormat& format);
+		void WriteNumber(unsigned long number, const NumberFormat& format);
+		void WriteNumber(unsigned long long number, const NumberFormat& format);
+		void WriteNumber(float number, const NumberFormat& format);
+		void WriteNumber(double number, const NumberFormat& format);
+		void WriteNumber(long double number, const NumberFormat& format);
 
 	private:
 		friend class Serializer;
@@ -38,10 +91,44 @@ namespace Pargon
 
 			template<typename T> static constexpr bool CanWriteAsMethod = HasToStringMethod<T, StringWriter>::value;
 			template<typename T> static constexpr bool CanWriteAsFunction = HasToStringFunction<T, StringWriter>::value;
+
+			template<typename T> static constexpr bool IsCharacter = std::is_same<T, char>::value || std::is_same<T, wchar_t>::value || std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value;
+			template<typename T> static constexpr bool IsNumber = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && !IsCharacter<T>;
 		};
 
 		String _string;
 
+		char* _buffer = nullptr;
+		int _capacity = 0;
+		int _size = 0;
+		bool _external = false;
+		bool _overflowToHeap = false;
+		bool _overflowed = false;
+
+		struct Chunk
+		{
+			std::unique_ptr<char[]> Characters;
+			int Size;
+			int Capacity;
+		};
+
+		mutable List<Chunk> _chunks;
+		mutable List<Chunk> _spareChunks;
+		int _chunkSize = 0;
+
+		FlushFunction _flush;
+		std::unique_ptr<char[]> _storage;
+		long long _flushed = 0;
+		bool _failed = false;
+
+		List<char> _reserved;
+		bool _reservedInPlace = false;
+
+		void MoveFrom(StringWriter& other);
+		void Append(const char* characters, int count);
+		void AddChunk(int capacity) const;
+		void Flatten() const;
+
 		void Write_(char character, StringView format);
 		void Write_(wchar_t character, StringView format);
 		void Write_(char16_t character, StringView format);
@@ -73,18 +160,41 @@ namespace Pargon
 		template<typename ItemType> void WriteSequence(SequenceView<ItemType> sequence, StringView format);
 
 		static void WriteNamedParameter(StringWriter& writer, const FormatToken& token) {}
-		template<int N> static void WriteIndexedParameter(StringWriter& writer, const FormatToken& token) {}
 		template<typename U, typename... Us> static void WriteNamedParameter(StringWriter& writer, const FormatToken& token, const U& parameter, const Us&... parameters);
-		template<int N, typename U, typename... Us> static void WriteIndexedParameter(StringWriter& writer, const FormatToken& token, const U& parameter, const Us&... parameters);
+		template<typename... Ts> void WriteFormatToken(const FormatToken& token, const void* const* parameters, const Ts&... inputs);
+		template<typename U> static void WriteParameter(StringWriter& writer, const FormatToken& token, const void* parameter);
+		template<typename T> void WriteToken(const T& value, const FormatToken& token);
+		template<typename FormatType, std::size_t... Ns, typename... Ts> void WriteStaticTokens(std::index_sequence<Ns...>, const Ts&... inputs);
+		template<typename FormatType, int N, typename... Ts> void WriteStaticToken(const Ts&... inputs);
 
 		template<typename T> void Serialize(T&& value);
 		template<typename T> void Serialize(StringView name, T&& value);
 		template<typename T> void Serialize(StringView name, T&& value, const T& defaultValue);
 	};
 
+	template<int N>
+	class StackStringWriter : public StringWriter
+	{
+	public:
+		StackStringWriter();
+
+		// the base writer points into _storage so a copy or move would keep writing to the original
+
+		StackStringWriter(const StackStringWriter&) = delete;
+		auto operator=(const StackStringWriter&) -> StackStringWriter& = delete;
+
+	private:
+		char _storage[N];
+	};
+
+	auto FlushToFile(std::FILE* file) -> StringWriter::FlushFunction;
+	auto FlushToDescriptor(int descriptor) -> StringWriter::FlushFunction;
+
 	template<typename T> auto WriteToString(const T& item, StringView format) -> String;
 	template<typename... Ts> auto FormatString(StringView format, const Ts&... inputs) -> String;
-	template<typename... Ts> auto FormatString(StringFormat format, const Ts&... inputs) -> String;
+	template<typename... Ts> auto FormatString(const StringFormat& format, const Ts&... inputs) -> String;
+	template<typename TextType, typename... Ts> auto FormatString(StaticFormat<TextType> format, const Ts&... inputs) -> String;
+	template<typename FormatType, typename... Ts> auto FormatTo(char* buffer, int capacity, const FormatType& format, const Ts&... inputs) -> int;
 }
 
 template<typename T>
@@ -103,19 +213,129 @@ constexpr auto Pargon::StringWriter::CanWrite() -> bool
 	return _canWriteAsMethod || _canWriteAsFunction || _canSerializeAsMethod || _canSerializeAsFunction || _canWriteAsEnum || _canWriteAsBuffer || _canWriteAsString || _canWriteAsText || _canWriteAsSequence;
 }
 
+inline
+Pargon::StringWriter::StringWriter(char* buffer, int capacity) :
+	_buffer(buffer),
+	_capacity(capacity),
+	_external(true)
+{
+}
+
+inline
+Pargon::StringWriter::StringWriter(char* buffer, int capacity, bool overflowToHeap) :
+	_buffer(buffer),
+	_capacity(capacity),
+	_external(true),
+	_overflowToHeap(overflowToHeap)
+{
+}
+
+inline
+Pargon::StringWriter::StringWriter(char* buffer, int capacity, FlushFunction flush) :
+	_buffer(buffer),
+	_capacity(capacity),
+	_external(true),
+	_flush(std::move(flush))
+{
+}
+
+inline
+Pargon::StringWriter::StringWriter(int threshold, FlushFunction flush) :
+	_capacity(threshold),
+	_external(true),
+	_flush(std::move(flush)),
+	_storage(new char[threshold])
+{
+	_buffer = _storage.get();
+}
+
+inline
+Pargon::StringWriter::~StringWriter()
+{
+	Flush();
+}
+
+inline
+Pargon::StringWriter::StringWriter(int chunkSize) :
+	_chunkSize(chunkSize)
+{
+}
+
 inline
 auto Pargon::StringWriter::GetString() const -> StringView
 {
-	return _string;
+	if (_chunkSize > 0)
+	{
+		Flatten();
+		return _chunks.IsEmpty() ? StringView{} : GetChunk(0);
+	}
+
+	if (!_external || _overflowed)
+		return _string;
+
+	return { _buffer, _size < _capacity ? _size : _capacity };
 }
 
 inline
 auto Pargon::StringWriter::ExtractString() -> String
 {
+	if (_chunkSize > 0)
+	{
+		_string.Clear();
+
+		for (auto& chunk : _chunks)
+			_string.Append(StringView{ chunk.Characters.get(), chunk.Size });
+
+		_chunks.Clear();
+		_size = 0;
+	}
+	else if (_external && !_overflowed)
+	{
+		_string.Clear();
+		_string.Append(GetString());
+	}
+
 	auto string = std::move(_string);
 	return string;
 }
 
+inline
+auto Pargon::StringWriter::RequiredSize() const -> int
+{
+	return (!_external && _chunkSize == 0) || _overflowed ? _string.Length() : _size;
+}
+
+inline
+auto Pargon::StringWriter::IsTruncated() const -> bool
+{
+	return _external && !_overflowed && _size > _capacity;
+}
+
+inline
+auto Pargon::StringWriter::ChunkCount() const -> int
+{
+	return _chunks.Count();
+}
+
+inline
+auto Pargon::StringWriter::GetChunk(int index) const -> StringView
+{
+	auto& chunk = _chunks.Item(index);
+	return { chunk.Characters.get(), chunk.Size };
+}
+
+inline
+auto Pargon::StringWriter::FlushedSize() const -> long long
+{
+	return _flushed;
+}
+
+inline
+auto Pargon::StringWriter::HasFailed() const -> bool
+{
+	return _failed;
+}
+
 inline
 void Pargon::StringWriter::Write(StringView string)
 {
@@ -131,22 +351,38 @@ void Pargon::StringWriter::Write(const T& item, StringView format)
 template<typename... Ts>
 void Pargon::StringWriter::Format(StringView format, const Ts&... inputs)
 {
-	auto tokens = ParseFormatString(format);
-	Format(tokens, inputs...);
+	// each token is written as soon as it is read so formatting a runtime string never builds a token list
+
+	const void* parameters[] = { std::addressof(inputs)..., nullptr };
+
+	FormatToken token;
+	auto cursor = 0;
+	auto nextIndex = 0;
+
+	while (ReadFormatToken(format, cursor, nextIndex, token))
+		WriteFormatToken(token, parameters, inputs...);
 }
 
 template<typename... Ts>
-void Pargon::StringWriter::Format(StringFormat format, const Ts&... inputs)
+void Pargon::StringWriter::Format(const StringFormat& format, const Ts&... inputs)
 {
+	const void* parameters[] = { std::addressof(inputs)..., nullptr };
+
 	for (auto& token : format.Tokens)
-	{
-		if (token.ParameterIndex == FormatToken::NoParameter)
-			WriteString(token.Specification, {});
-		else if (token.ParameterIndex == FormatToken::NamedParameter)
-			WriteNamedParameter(*this, token, inputs...);
-		else
-			WriteIndexedParameter<0>(*this, token, inputs...);
-	}
+		WriteFormatToken(token, parameters, inputs...);
+}
+
+template<typename TextType, typename... Ts>
+void Pargon::StringWriter::Format(StaticFormat<TextType> format, const Ts&... inputs)
+{
+	using FormatType = StaticFormat<TextType>;
+
+	constexpr auto passed = sizeof...(Ts) >= 64 ? ~0ull : (1ull << sizeof...(Ts)) - 1;
+
+	static_assert(FormatType::Format.ParameterCount <= sizeof...(Ts), "format string uses a parameter index that was not passed");
+	static_assert(FormatType::Format.HasNamedParameters || FormatType::Format.UsedParameters == passed, "format string does not use every parameter");
+
+	WriteStaticTokens<FormatType>(std::make_index_sequence<FormatType::Format.IsValid ? FormatType::Count : 0>{}, inputs...);
 }
 
 template<typename KeyType, typename ItemType>
@@ -267,7 +503,7 @@ void Pargon::StringWriter::WriteNamedParameter(StringWriter& writer, const Forma
 	if constexpr (isFormatArgument)
 	{
 		if (Equals(parameter.Name, token.ParameterName))
-			writer.Write(parameter.Value, token.Specification);
+			writer.WriteToken(parameter.Value, token);
 		else
 			WriteNamedParameter(writer, token, parameters...);
 	}
@@ -277,13 +513,76 @@ void Pargon::StringWriter::WriteNamedParameter(StringWriter& writer, const Forma
 	}
 }
 
-template<int N, typename U, typename... Us>
-void Pargon::StringWriter::WriteIndexedParameter(StringWriter& writer, const FormatToken& token, const U& parameter, const Us&... parameters)
+template<typename... Ts>
+void Pargon::StringWriter::WriteFormatToken(const FormatToken& token, const void* const* parameters, const Ts&... inputs)
+{
+	// indexed parameters, including named parameters resolved by BindFormat, dispatch straight to the writer for their type
+
+	using ParameterWriter = void(*)(StringWriter&, const FormatToken&, const void*);
+
+	static constexpr ParameterWriter writers[] = { &WriteParameter<Ts>..., nullptr };
+
+	if (token.ParameterIndex == FormatToken::NoParameter)
+		WriteString(token.Specification, {});
+	else if (token.ParameterIndex == FormatToken::NamedParameter)
+		WriteNamedParameter(*this, token, inputs...);
+	else if (token.ParameterIndex < static_cast<int>(sizeof...(Ts)))
+		writers[token.ParameterIndex](*this, token, parameters[token.ParameterIndex]);
+}
+
+template<typename U>
+void Pargon::StringWriter::WriteParameter(StringWriter& writer, const FormatToken& token, const void* parameter)
 {
-	if (token.ParameterIndex == N)
-		writer.Write(parameter, token.Specification);
+	constexpr auto isFormatArgument = SerializationTraits::IsFormatArgument<U>;
+
+	if constexpr (isFormatArgument)
+		writer.WriteToken(static_cast<const U*>(parameter)->Value, token);
 	else
-		WriteIndexedParameter<N + 1>(writer, token, parameters...);
+		writer.WriteToken(*static_cast<const U*>(parameter), token);
+}
+
+template<typename T>
+void Pargon::StringWriter::WriteToken(const T& value, const FormatToken& token)
+{
+	// numbers use the specification that was parsed along with the format instead of parsing it again
+
+	if constexpr (Traits::IsNumber<T>)
+		WriteNumber(value, token.Number);
+	else
+		Write_(value, token.Specification);
+}
+
+template<typename FormatType, std::size_t... Ns, typename... Ts>
+void Pargon::StringWriter::WriteStaticTokens(std::index_sequence<Ns...>, const Ts&... inputs)
+{
+	(WriteStaticToken<FormatType, static_cast<int>(Ns)>(inputs...), ...);
+}
+
+template<typename FormatType, int N, typename... Ts>
+void Pargon::StringWriter::WriteStaticToken(const Ts&... inputs)
+{
+	constexpr auto token = FormatType::Format.Tokens[N];
+
+	auto specification = StringView{ FormatType::Text + token.SpecificationStart, token.SpecificationLength };
+
+	if constexpr (token.ParameterIndex == FormatToken::NoParameter)
+	{
+		WriteString(specification, {});
+	}
+	else if constexpr (token.ParameterIndex == FormatToken::NamedParameter)
+	{
+		auto name = StringView{ FormatType::Text + token.NameStart, token.NameLength };
+		WriteNamedParameter(*this, { token.ParameterIndex, name, specification, token.Number }, inputs...);
+	}
+	else
+	{
+		// the parameter type is not decayed so arrays such as string literals are dispatched the same way Format does
+
+		using ParameterType = std::tuple_element_t<token.ParameterIndex, std::tuple<Ts...>>;
+
+		auto& parameter = std::get<token.ParameterIndex>(std::tie(inputs...));
+		WriteParameter<ParameterType>(*this, { token.ParameterIndex, {}, specification, token.Number }, std::addressof(parameter));
+	}
 }
 
 template<typename T>
@@ -321,9 +620,58 @@ auto Pargon::FormatString(StringView format, const Ts&... inputs) -> String
 }
 
 template<typename... Ts>
-auto Pargon::FormatString(StringFormat format, const Ts&... inputs) -> String
+auto Pargon::FormatString(const StringFormat& format, const Ts&... inputs) -> String
+{
+	StringWriter writer;
+	writer.Format(format, inputs...);
+	return writer.ExtractString();
+}
+
+template<typename TextType, typename... Ts>
+auto Pargon::FormatString(StaticFormat<TextType> format, const Ts&... inputs) -> String
 {
 	StringWriter writer;
 	writer.Format(format, inputs...);
 	return writer.ExtractString();
+}
+
+template<typename FormatType, typename... Ts>
+auto Pargon::FormatTo(char* buffer, int capacity, const FormatType& format, const Ts&... inputs) -> int
+{
+	// writes at most capacity - 1 characters followed by a null terminator and returns the length the full result
+	// needed - a result cut short is ended on a utf-8 character boundary, and a null buffer just counts
+
+	StringWriter writer(buffer, capacity > 0 ? capacity - 1 : 0);
+	writer.Format(format, inputs...);
+
+	if (capacity > 0)
+	{
+		auto length = writer.GetString().Length();
+
+		if (writer.IsTruncated())
+		{
+			auto start = length;
+			while (start > 0 && (static_cast<unsigned char>(buffer[start - 1]) & 0xC0) == 0x80)
+				start--;
+
+			if (start > 0)
+			{
+				auto lead = static_cast<unsigned char>(buffer[start - 1]);
+				auto expected = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+
+				if (length - start + 1 < expected)
+					length = start - 1;
+			}
+		}
+
+		buffer[length] = '\0';
+	}
+
+	return writer.RequiredSize();
+}
+
+template<int N>
+Pargon::StackStringWriter<N>::StackStringWriter() :
+	StringWriter(_storage, N, true)
+{
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Pargon
+{
+	class WorkPool
+	{
+	public:
+		using Task = std::function<void(int task, int worker)>;
+
+		WorkPool(int workerCount);
+		~WorkPool();
+
+		WorkPool(const WorkPool&) = delete;
+		auto operator=(const WorkPool&) -> WorkPool& = delete;
+
+		auto WorkerCount() const -> int;
+
+		void Run(int taskCount, const Task& task);
+
+	private:
+		struct Queue
+		{
+			std::atomic<uint64_t> Range;
+		};
+
+		std::unique_ptr<std::thread[]> _threads;
+		std::unique_ptr<Queue[]> _queues;
+		int _workerCount;
+
+		std::mutex _mutex;
+		std::condition_variable _start;
+		std::condition_variable _finish;
+
+		const Task* _task = nullptr;
+		int _generation = 0;
+		int _active = 0;
+		bool _stopping = false;
+
+		std::atomic<int> _remaining;
+
+		void Work(int worker);
+		void Drain(int worker);
+		auto Pop(int worker, int& task) -> bool;
+		auto Steal(int victim, int& task) -> bool;
+	};
+}
+
+inline
+auto Pargon::WorkPool::WorkerCount() const -> int
+{
+	return _workerCount;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Pargon/Containers/List.h"
+
+#include <utility>
+
+namespace Pargon
+{
+	template<typename WriterType> class WriterPool;
+
+	template<typename WriterType>
+	class PooledWriter
+	{
+	public:
+		PooledWriter(PooledWriter&& other);
+		~PooledWriter();
+
+		PooledWriter(const PooledWriter&) = delete;
+		auto operator=(const PooledWriter&) -> PooledWriter& = delete;
+
+		auto operator*() const -> WriterType&;
+		auto operator->() const -> WriterType*;
+
+	private:
+		friend class WriterPool<WriterType>;
+
+		PooledWriter(WriterType* writer);
+
+		WriterType* _writer;
+	};
+
+	template<typename WriterType>
+	class WriterPool
+	{
+	public:
+		static constexpr int MaximumIdle = 8;
+
+		static auto Acquire() -> PooledWriter<WriterType>;
+
+	private:
+		friend class PooledWriter<WriterType>;
+
+		struct Idle
+		{
+			List<WriterType*> Writers;
+			~Idle();
+		};
+
+		static auto GetIdle() -> Idle&;
+		static auto IsIdleDestroyed() -> bool&;
+		static void Release(WriterType* writer);
+	};
+}
+
+template<typename WriterType>
+Pargon::PooledWriter<WriterType>::PooledWriter(WriterType* writer) :
+	_writer(writer)
+{
+}
+
+template<typename WriterType>
+Pargon::PooledWriter<WriterType>::PooledWriter(PooledWriter&& other) :
+	_writer(std::exchange(other._writer, nullptr))
+{
+}
+
+template<typename WriterType>
+Pargon::PooledWriter<WriterType>::~PooledWriter()
+{
+	if (_writer != nullptr)
+		WriterPool<WriterType>::Release(_writer);
+}
+
+template<typename WriterType>
+auto Pargon::PooledWriter<WriterType>::operator*() const -> WriterType&
+{
+	return *_writer;
+}
+
+template<typename WriterType>
+auto Pargon::PooledWriter<WriterType>::operator->() const -> WriterType*
+{
+	return _writer;
+}
+
+template<typename WriterType>
+Pargon::WriterPool<WriterType>::Idle::~Idle()
+{
+	for (auto writer : Writers)
+		delete writer;
+
+	IsIdleDestroyed() = true;
+}
+
+template<typename WriterType>
+auto Pargon::WriterPool<WriterType>::GetIdle() -> Idle&
+{
+	static thread_local Idle idle;
+	return idle;
+}
+
+template<typename WriterType>
+auto Pargon::WriterPool<WriterType>::IsIdleDestroyed() -> bool&
+{
+	// a plain bool is never destroyed so it can still be checked by writers acquired or released after the idle list
+	// has gone away during thread exit
+
+	static thread_local bool destroyed = false;
+	return destroyed;
+}
+
+template<typename WriterType>
+auto Pargon::WriterPool<WriterType>::Acquire() -> PooledWriter<WriterType>
+{
+	if (IsIdleDestroyed())
+		return { new WriterType() };
+
+	auto& idle = GetIdle();
+
+	if (idle.Writers.IsEmpty())
+		return { new WriterType() };
+
+	auto writer = idle.Writers.Last();
+	idle.Writers.RemoveLast();
+	return { writer };
+}
+
+template<typename WriterType>
+void Pargon::WriterPool<WriterType>::Release(WriterType* writer)
+{
+	// writers are reset as they are returned so their storage is kept but their contents are not
+
+	if (IsIdleDestroyed())
+	{
+		delete writer;
+		return;
+	}
+
+	auto& idle = GetIdle();
+
+	if (idle.Writers.Count() < MaximumIdle)
+	{
+		writer->Reset();
+		idle.Writers.Add(writer);
+	}
+	else
+	{
+		delete writer;
+	}
+}
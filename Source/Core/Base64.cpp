@@ -0,0 +1,224 @@
+#include "Core/Base64.h"
+
+#include <cstring>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+	#define PARGON_BASE64_SSSE3
+	#include <tmmintrin.h>
+#endif
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr char Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	struct DecodeTable
+	{
+		int8_t Values[256];
+
+		DecodeTable()
+		{
+			std::memset(Values, -1, sizeof(Values));
+
+			for (auto i = 0; i < 64; i++)
+				Values[static_cast<uint8_t>(Alphabet[i])] = static_cast<int8_t>(i);
+		}
+	};
+
+	auto GetDecodeTable() -> const DecodeTable&
+	{
+		static const DecodeTable table;
+		return table;
+	}
+
+	auto IsBase64(const DecodeTable& table, char character) -> bool
+	{
+		return table.Values[static_cast<uint8_t>(character)] >= 0;
+	}
+
+#if defined(PARGON_BASE64_SSSE3)
+	// the vector paths follow Wojciech Muła's pshufb based base64 encoding and decoding
+
+	auto EncodeBlock(__m128i bytes) -> __m128i
+	{
+		// spreads 12 bytes into 16 lanes of 6 bits and maps each lane to its character with a table of offsets
+
+		auto input = _mm_shuffle_epi8(bytes, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		auto high = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+		auto low = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+		auto indices = _mm_or_si128(high, low);
+
+		auto offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+		auto reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		auto less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+
+		reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+		return _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+	}
+
+	auto FindInvalid(__m128i characters) -> int
+	{
+		// returns a bit for each lane that is not in the alphabet - the low nibble selects which high nibbles are valid
+
+		auto masks = _mm_setr_epi8(static_cast<char>(0xA8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF0), 0x54, 0x50, 0x50, 0x50, 0x54);
+		auto bits = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+
+		auto high = _mm_and_si128(_mm_srli_epi32(characters, 4), _mm_set1_epi8(0x0F));
+		auto low = _mm_and_si128(characters, _mm_set1_epi8(0x0F));
+		auto valid = _mm_and_si128(_mm_shuffle_epi8(masks, low), _mm_shuffle_epi8(bits, high));
+
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128()));
+	}
+
+	auto DecodeBlock(__m128i characters) -> __m128i
+	{
+		// maps each character to its 6 bit value and packs the 16 values into the first 12 bytes
+
+		auto high = _mm_and_si128(_mm_srli_epi32(characters, 4), _mm_set1_epi8(0x0F));
+		auto shifts = _mm_shuffle_epi8(_mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0), high);
+		auto slash = _mm_cmpeq_epi8(characters, _mm_set1_epi8('/'));
+
+		shifts = _mm_or_si128(_mm_andnot_si128(slash, shifts), _mm_and_si128(slash, _mm_set1_epi8(16)));
+
+		auto values = _mm_add_epi8(characters, shifts);
+		auto pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+		auto packed = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+		return _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	}
+#endif
+}
+
+auto Pargon::Base64EncodedSize(int size) -> int
+{
+	return (size + 2) / 3 * 4;
+}
+
+void Pargon::EncodeBase64(const uint8_t* data, int size, char* output)
+{
+	auto index = 0;
+
+#if defined(PARGON_BASE64_SSSE3)
+	// each block reads 16 bytes but only encodes 12 of them
+
+	for (; size - index >= 16; index += 12, output += 16)
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output), EncodeBlock(bytes));
+	}
+#endif
+
+	for (; size - index >= 3; index += 3, output += 4)
+	{
+		auto group = (static_cast<uint32_t>(data[index]) << 16) | (static_cast<uint32_t>(data[index + 1]) << 8) | data[index + 2];
+
+		output[0] = Alphabet[group >> 18];
+		output[1] = Alphabet[(group >> 12) & 0x3F];
+		output[2] = Alphabet[(group >> 6) & 0x3F];
+		output[3] = Alphabet[group & 0x3F];
+	}
+
+	if (size - index == 1)
+	{
+		auto group = static_cast<uint32_t>(data[index]) << 16;
+
+		output[0] = Alphabet[group >> 18];
+		output[1] = Alphabet[(group >> 12) & 0x3F];
+		output[2] = '=';
+		output[3] = '=';
+	}
+	else if (size - index == 2)
+	{
+		auto group = (static_cast<uint32_t>(data[index]) << 16) | (static_cast<uint32_t>(data[index + 1]) << 8);
+
+		output[0] = Alphabet[group >> 18];
+		output[1] = Alphabet[(group >> 12) & 0x3F];
+		output[2] = Alphabet[(group >> 6) & 0x3F];
+		output[3] = '=';
+	}
+}
+
+auto Pargon::FindBase64End(const char* begin, const char* end) -> const char*
+{
+	// the run of alphabet characters at begin followed by at most two padding characters
+
+	auto& table = GetDecodeTable();
+	auto cursor = begin;
+
+#if defined(PARGON_BASE64_SSSE3)
+	for (; end - cursor >= 16; cursor += 16)
+	{
+		auto invalid = FindInvalid(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor)));
+
+		if (invalid != 0)
+			break;
+	}
+#endif
+
+	while (cursor < end && IsBase64(table, *cursor))
+		cursor++;
+
+	for (auto i = 0; i < 2 && cursor < end && *cursor == '='; i++)
+		cursor++;
+
+	return cursor;
+}
+
+auto Pargon::Base64DecodedSize(const char* text, int length) -> int
+{
+	while (length > 0 && text[length - 1] == '=')
+		length--;
+
+	auto remainder = length % 4;
+	return length / 4 * 3 + (remainder == 3 ? 2 : remainder == 2 ? 1 : 0);
+}
+
+void Pargon::DecodeBase64(const char* text, int length, uint8_t* output)
+{
+	// text is expected to be a run found by FindBase64End - a trailing single character carries no whole byte and is
+	// ignored
+
+	auto& table = GetDecodeTable();
+
+	while (length > 0 && text[length - 1] == '=')
+		length--;
+
+	auto index = 0;
+
+#if defined(PARGON_BASE64_SSSE3)
+	for (; length - index >= 16; index += 16, output += 12)
+	{
+		alignas(16) uint8_t block[16];
+		_mm_store_si128(reinterpret_cast<__m128i*>(block), DecodeBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + index))));
+		std::memcpy(output, block, 12);
+	}
+#endif
+
+	for (; length - index >= 4; index += 4, output += 3)
+	{
+		auto group = (static_cast<uint32_t>(table.Values[static_cast<uint8_t>(text[index])]) << 18)
+			| (static_cast<uint32_t>(table.Values[static_cast<uint8_t>(text[index + 1])]) << 12)
+			| (static_cast<uint32_t>(table.Values[static_cast<uint8_t>(text[index + 2])]) << 6)
+			| static_cast<uint32_t>(table.Values[static_cast<uint8_t>(text[index + 3])]);
+
+		output[0] = static_cast<uint8_t>(group >> 16);
+		output[1] = static_cast<uint8_t>(group >> 8);
+		output[2] = static_cast<uint8_t>(group);
+	}
+
+	auto remainder = length - index;
+
+	if (remainder >= 2)
+	{
+		auto group = (static_cast<uint32_t>(table.Values[static_cast<uint8_t>(text[index])]) << 18) | (static_cast<uint32_t>(table.Values[static_cast<uint8_t>(text[index + 1])]) << 12);
+
+		if (remainder == 3)
+			group |= static_cast<uint32_t>(table.Values[static_cast<uint8_t>(text[index + 2])]) << 6;
+
+		output[0] = static_cast<uint8_t>(group >> 16);
+
+		if (remainder == 3)
+			output[1] = static_cast<uint8_t>(group >> 8);
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pargon
+{
+	auto Base64EncodedSize(int size) -> int;
+	void EncodeBase64(const uint8_t* data, int size, char* output);
+
+	auto FindBase64End(const char* begin, const char* end) -> const char*;
+	auto Base64DecodedSize(const char* text, int length) -> int;
+	void DecodeBase64(const char* text, int length, uint8_t* output);
+}
@@ -0,0 +1,78 @@
+#include "Pargon/Serialization/BatchReader.h"
+
+#include <cstring>
+
+using namespace Pargon;
+
+namespace
+{
+	// the trailer written by BatchWriter::Finish is little endian regardless of the machine that wrote it
+
+	constexpr auto EncodedEntrySize = 2 * static_cast<int>(sizeof(int));
+
+	auto ReadTrailer(BufferView view) -> BufferReader
+	{
+		BufferReader reader(view);
+		reader.SetEndian(Endian::Little);
+		return reader;
+	}
+}
+
+BatchReader::BatchReader(BufferView batch)
+{
+	int count;
+	auto size = batch.Size();
+
+	if (size < static_cast<int>(sizeof(count)))
+		return;
+
+	if (!ReadTrailer({ batch.begin() + size - sizeof(count), static_cast<int>(sizeof(count)) }).Read(count))
+		return;
+
+	auto indexSize = static_cast<long long>(count) * EncodedEntrySize;
+	if (count < 0 || indexSize > size - static_cast<long long>(sizeof(count)))
+		return;
+
+	auto dataSize = size - static_cast<int>(sizeof(count)) - static_cast<int>(indexSize);
+
+	_data = { batch.begin(), dataSize };
+	_index = { batch.begin() + dataSize, static_cast<int>(indexSize) };
+	_count = count;
+	_isEncoded = true;
+	_isValid = true;
+}
+
+BatchReader::BatchReader(BufferView data, SequenceView<BatchEntry> index) :
+	_data(data),
+	_index(reinterpret_cast<const uint8_t*>(index.begin()), index.Count() * static_cast<int>(sizeof(BatchEntry))),
+	_count(index.Count()),
+	_isValid(true)
+{
+}
+
+auto BatchReader::GetView(int index) const -> BufferView
+{
+	if (index < 0 || index >= _count)
+		return {};
+
+	// an index passed in directly is still the writer's own list of entries rather than the encoded trailer
+
+	BatchEntry entry;
+
+	if (_isEncoded)
+	{
+		auto reader = ReadTrailer({ _index.begin() + index * EncodedEntrySize, EncodedEntrySize });
+
+		if (!reader.Read(entry.Offset) || !reader.Read(entry.Length))
+			return {};
+	}
+	else
+	{
+		std::memcpy(std::addressof(entry), _index.begin() + index * sizeof(BatchEntry), sizeof(BatchEntry));
+	}
+
+	if (entry.Offset < 0 || entry.Length < 0 || entry.Length > _data.Size() - entry.Offset)
+		return {};
+
+	return { _data.begin() + entry.Offset, entry.Length };
+}
@@ -0,0 +1,28 @@
+#include "Pargon/Serialization/BatchWriter.h"
+
+using namespace Pargon;
+
+auto BatchWriter::Finish() -> BufferView
+{
+	// the index is appended as a trailer so the whole batch can be sent as a single buffer
+	// layout: offset and length of each item followed by the item count, always little endian so a batch can be read
+	// on a machine other than the one that wrote it
+
+	if (!_finished)
+	{
+		auto endian = _writer.Endian();
+		_writer.SetEndian(Endian::Little);
+
+		for (auto& entry : _index)
+		{
+			_writer.Write(entry.Offset);
+			_writer.Write(entry.Length);
+		}
+
+		_writer.Write(_index.Count());
+		_writer.SetEndian(endian);
+		_finished = true;
+	}
+
+	return _writer.GetBuffer();
+}
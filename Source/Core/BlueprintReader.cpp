@@ -2,6 +2,7 @@
 #include "Pargon/Containers/Blueprint.h"
 #include "Pargon/Containers/String.h"
 #include "Pargon/Serialization/BlueprintReader.h"
+#include "Core/Base64.h"
 
 using namespace Pargon;
 
@@ -222,7 +223,23 @@ auto BlueprintReader::Read_(Buffer& buffer) -> bool
 	if (_current->IsString())
 	{
 		auto string = _current->AsStringView();
-		buffer = FromBase64(string);
+		auto length = static_cast<int>(FindBase64End(string.begin(), string.end()) - string.begin());
+		auto digits = length;
+
+		while (digits > 0 && string.begin()[digits - 1] == '=')
+			digits--;
+
+		// the whole string has to be base64 - a stray character or a lone final digit means the data is damaged
+
+		if (length != string.Length() || digits % 4 == 1)
+		{
+			ReportError("invalid base64 data");
+			return false;
+		}
+
+		auto size = Base64DecodedSize(string.begin(), length);
+
+		DecodeBase64(string.begin(), length, static_cast<uint8_t*>(buffer.GetReference(size).begin()));
 		return true;
 	}
 
@@ -13,6 +13,16 @@ BufferReader::BufferReader(BufferView view) :
 {
 }
 
+void BufferReader::Rebind(BufferView view)
+{
+	_data = view.begin();
+	_length = view.Size();
+	_index = 0;
+	_bitIndex = 0;
+	_hasFailed = false;
+	_errors.Clear();
+}
+
 void BufferReader::ReportError(StringView message)
 {
 	_hasFailed = true;
@@ -64,7 +74,7 @@ auto BufferReader::ViewBytes(int count) -> BufferView
 	if (_hasFailed)
 		return {};
 
-	if (count < 0 || _index + count > _length)
+	if (count < 0 || count > _length - _index)
 	{
 		ReportError("attempted to view past the end of the buffer");
 		return {};
@@ -92,7 +102,7 @@ auto BufferReader::ReadBytes(int count) -> BufferView
 	if (_hasFailed)
 		return {};
 
-	if (count < 0 || _index + count > _length)
+	if (count < 0 || count > _length - _index)
 	{
 		ReportError("attempted to read past the end of the buffer");
 		return {};
@@ -18,6 +18,15 @@ void BufferWriter::WriteBytes(BufferView data, bool correctEndian)
 	_buffer.Append(data, correctEndian && _endian != NativeEndian);
 }
 
+void BufferWriter::OverwriteBytes(int index, BufferView data, bool correctEndian)
+{
+	auto reverse = correctEndian && _endian != NativeEndian;
+	auto size = std::min(data.Size(), _buffer.Size() - index);
+
+	for (auto i = 0; i < size; i++)
+		_buffer.SetByte(index + i, reverse ? data.begin()[data.Size() - i - 1] : data.begin()[i]);
+}
+
 namespace
 {
 	auto GetBit(int index, bool bit) -> unsigned char
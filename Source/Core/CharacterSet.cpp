@@ -0,0 +1,201 @@
+#include "Pargon/Serialization/CharacterSet.h"
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSSE3__)
+	#define PARGON_CHARACTER_SET_SSSE3
+	#include <tmmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+using namespace Pargon;
+
+namespace
+{
+	auto LowestBit(unsigned int mask) -> int
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	auto HighestBit(unsigned int mask) -> int
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, mask);
+		return static_cast<int>(index);
+#else
+		return 31 - __builtin_clz(mask);
+#endif
+	}
+
+	// the row for each character is shuffled out of the table for its low nibble and the bit for its high nibble out
+	// of a second shuffle - the character is in the set when the row has that bit
+
+#if defined(__AVX2__)
+	constexpr int BlockSize = 32;
+	constexpr unsigned int BlockMask = 0xFFFFFFFFu;
+
+	struct Tables
+	{
+		__m256i Low;
+		__m256i High;
+		__m256i Bits;
+		__m256i Nibble;
+	};
+
+	auto LoadTables(const uint8_t* low, const uint8_t* high) -> Tables
+	{
+		auto lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low));
+		auto highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high));
+		auto bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+		return { _mm256_broadcastsi128_si256(lowTable), _mm256_broadcastsi128_si256(highTable), _mm256_broadcastsi128_si256(bits), _mm256_set1_epi8(0x0F) };
+	}
+
+	auto Members(const Tables& tables, const char* block) -> unsigned int
+	{
+		auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+		auto low = _mm256_and_si256(bytes, tables.Nibble);
+		auto high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), tables.Nibble);
+		auto rows = _mm256_blendv_epi8(_mm256_shuffle_epi8(tables.Low, low), _mm256_shuffle_epi8(tables.High, low), bytes);
+		auto bits = _mm256_shuffle_epi8(tables.Bits, high);
+
+		return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(rows, bits), bits)));
+	}
+#elif defined(PARGON_CHARACTER_SET_SSSE3)
+	constexpr int BlockSize = 16;
+	constexpr unsigned int BlockMask = 0xFFFFu;
+
+	struct Tables
+	{
+		__m128i Low;
+		__m128i High;
+		__m128i Bits;
+		__m128i Nibble;
+	};
+
+	auto LoadTables(const uint8_t* low, const uint8_t* high) -> Tables
+	{
+		auto lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low));
+		auto highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high));
+		auto bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+		return { lowTable, highTable, bits, _mm_set1_epi8(0x0F) };
+	}
+
+	auto Members(const Tables& tables, const char* block) -> unsigned int
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+		auto low = _mm_and_si128(bytes, tables.Nibble);
+		auto high = _mm_and_si128(_mm_srli_epi16(bytes, 4), tables.Nibble);
+		auto upper = _mm_cmplt_epi8(bytes, _mm_setzero_si128());
+		auto rows = _mm_or_si128(_mm_andnot_si128(upper, _mm_shuffle_epi8(tables.Low, low)), _mm_and_si128(upper, _mm_shuffle_epi8(tables.High, low)));
+		auto bits = _mm_shuffle_epi8(tables.Bits, high);
+
+		return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(rows, bits), bits)));
+	}
+#endif
+
+	auto Find(StringView text, const CharacterSet& set, const uint8_t* low, const uint8_t* high, bool member) -> int
+	{
+		auto begin = text.begin();
+		auto end = begin + text.Length();
+		auto cursor = begin;
+
+#if defined(__AVX2__) || defined(PARGON_CHARACTER_SET_SSSE3)
+		if (end - cursor >= BlockSize)
+		{
+			auto tables = LoadTables(low, high);
+			auto flip = member ? 0u : BlockMask;
+
+			for (; end - cursor >= BlockSize; cursor += BlockSize)
+			{
+				auto mask = Members(tables, cursor) ^ flip;
+
+				if (mask != 0)
+					return static_cast<int>(cursor - begin) + LowestBit(mask);
+			}
+		}
+#endif
+
+		for (; cursor < end; cursor++)
+		{
+			if (set.Contains(*cursor) == member)
+				return static_cast<int>(cursor - begin);
+		}
+
+		return String::InvalidIndex;
+	}
+
+	auto FindLast(StringView text, const CharacterSet& set, const uint8_t* low, const uint8_t* high, bool member) -> int
+	{
+		auto begin = text.begin();
+		auto cursor = begin + text.Length();
+
+#if defined(__AVX2__) || defined(PARGON_CHARACTER_SET_SSSE3)
+		if (cursor - begin >= BlockSize)
+		{
+			auto tables = LoadTables(low, high);
+			auto flip = member ? 0u : BlockMask;
+
+			for (; cursor - begin >= BlockSize; cursor -= BlockSize)
+			{
+				auto mask = Members(tables, cursor - BlockSize) ^ flip;
+
+				if (mask != 0)
+					return static_cast<int>(cursor - BlockSize - begin) + HighestBit(mask);
+			}
+		}
+#endif
+
+		while (cursor > begin)
+		{
+			if (set.Contains(*--cursor) == member)
+				return static_cast<int>(cursor - begin);
+		}
+
+		return String::InvalidIndex;
+	}
+}
+
+CharacterSet::CharacterSet(StringView characters, bool ignoreCase)
+{
+	for (auto character : characters)
+	{
+		Add(character);
+
+		if (ignoreCase && character >= 'a' && character <= 'z')
+			Add(static_cast<char>(character - 'a' + 'A'));
+		else if (ignoreCase && character >= 'A' && character <= 'Z')
+			Add(static_cast<char>(character - 'A' + 'a'));
+	}
+}
+
+auto Pargon::IndexOfAny(StringView text, const CharacterSet& set) -> int
+{
+	return Find(text, set, set._low, set._high, true);
+}
+
+auto Pargon::IndexOfAnyOther(StringView text, const CharacterSet& set) -> int
+{
+	return Find(text, set, set._low, set._high, false);
+}
+
+auto Pargon::LastIndexOfAny(StringView text, const CharacterSet& set) -> int
+{
+	return FindLast(text, set, set._low, set._high, true);
+}
+
+auto Pargon::LastIndexOfAnyOther(StringView text, const CharacterSet& set) -> int
+{
+	return FindLast(text, set, set._low, set._high, false);
+}
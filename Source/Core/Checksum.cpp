@@ -0,0 +1,83 @@
+#include "Core/Checksum.h"
+
+#include <cstring>
+
+#if defined(__SSE4_2__)
+	#include <nmmintrin.h>
+#endif
+
+using namespace Pargon;
+
+namespace
+{
+	struct Crc32cTable
+	{
+		uint32_t Entries[8][256];
+
+		Crc32cTable()
+		{
+			for (auto i = 0u; i < 256; i++)
+			{
+				auto crc = i;
+
+				for (auto bit = 0; bit < 8; bit++)
+					crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+
+				Entries[0][i] = crc;
+			}
+
+			for (auto i = 0u; i < 256; i++)
+			{
+				for (auto slice = 1; slice < 8; slice++)
+					Entries[slice][i] = (Entries[slice - 1][i] >> 8) ^ Entries[0][Entries[slice - 1][i] & 0xFF];
+			}
+		}
+	};
+
+	auto GetCrc32cTable() -> const Crc32cTable&
+	{
+		static const Crc32cTable table;
+		return table;
+	}
+}
+
+auto Pargon::Crc32c(uint32_t crc, const uint8_t* data, int size) -> uint32_t
+{
+	crc = ~crc;
+
+#if defined(__SSE4_2__)
+	while (size >= 8)
+	{
+		uint64_t block;
+		std::memcpy(&block, data, 8);
+		crc = static_cast<uint32_t>(_mm_crc32_u64(crc, block));
+
+		data += 8;
+		size -= 8;
+	}
+
+	while (size-- > 0)
+		crc = _mm_crc32_u8(crc, *data++);
+#else
+	// slicing by 8 processes a little endian word per step using eight tables
+
+	auto& table = GetCrc32cTable().Entries;
+
+	while (size >= 8)
+	{
+		auto low = crc ^ (data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24));
+		auto high = data[4] | (data[5] << 8) | (data[6] << 16) | (static_cast<uint32_t>(data[7]) << 24);
+
+		crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24]
+			^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+
+		data += 8;
+		size -= 8;
+	}
+
+	while (size-- > 0)
+		crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+#endif
+
+	return ~crc;
+}
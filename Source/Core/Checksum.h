@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pargon
+{
+	auto Crc32c(uint32_t crc, const uint8_t* data, int size) -> uint32_t;
+}
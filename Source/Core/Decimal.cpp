@@ -0,0 +1,275 @@
+#include "Core/Decimal.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace Pargon;
+
+namespace
+{
+	class BigInteger
+	{
+	public:
+		// large enough for the significand of any double scaled by 2^1074 and 10^(324 + NumberFormat::MaximumPrecision)
+
+		static constexpr int Capacity = 48;
+
+		explicit BigInteger(uint64_t value)
+		{
+			_words[0] = static_cast<uint32_t>(value);
+			_words[1] = static_cast<uint32_t>(value >> 32);
+			_count = _words[1] != 0 ? 2 : _words[0] != 0 ? 1 : 0;
+		}
+
+		auto IsZero() const -> bool
+		{
+			return _count == 0;
+		}
+
+		auto IsOdd() const -> bool
+		{
+			return _count > 0 && (_words[0] & 1) != 0;
+		}
+
+		auto BitLength() const -> int
+		{
+			if (_count == 0)
+				return 0;
+
+			auto top = _words[_count - 1];
+			auto bits = 0;
+
+			while (top != 0)
+			{
+				top >>= 1;
+				bits++;
+			}
+
+			return (_count - 1) * 32 + bits;
+		}
+
+		void Add(uint32_t value)
+		{
+			for (auto i = 0; value != 0; i++)
+			{
+				if (i == _count)
+					_words[_count++] = 0;
+
+				auto sum = static_cast<uint64_t>(_words[i]) + value;
+				_words[i] = static_cast<uint32_t>(sum);
+				value = static_cast<uint32_t>(sum >> 32);
+			}
+		}
+
+		void Multiply(uint32_t factor)
+		{
+			uint64_t carry = 0;
+
+			for (auto i = 0; i < _count; i++)
+			{
+				auto product = static_cast<uint64_t>(_words[i]) * factor + carry;
+				_words[i] = static_cast<uint32_t>(product);
+				carry = product >> 32;
+			}
+
+			if (carry != 0)
+				_words[_count++] = static_cast<uint32_t>(carry);
+		}
+
+		void MultiplyByPowerOfTen(int power)
+		{
+			for (; power >= 9; power -= 9)
+				Multiply(1000000000u);
+
+			static constexpr uint32_t small[] = { 1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u };
+
+			if (power > 0)
+				Multiply(small[power]);
+		}
+
+		void ShiftLeft(int bits)
+		{
+			if (_count == 0 || bits == 0)
+				return;
+
+			auto words = bits / 32;
+			auto remainder = bits % 32;
+
+			if (remainder != 0)
+			{
+				_words[_count] = 0;
+
+				for (auto i = _count; i > 0; i--)
+					_words[i] = (_words[i] << remainder) | (_words[i - 1] >> (32 - remainder));
+
+				_words[0] <<= remainder;
+
+				if (_words[_count] != 0)
+					_count++;
+			}
+
+			if (words != 0)
+			{
+				std::memmove(_words + words, _words, _count * sizeof(uint32_t));
+				std::memset(_words, 0, words * sizeof(uint32_t));
+				_count += words;
+			}
+		}
+
+		void ShiftRightOne()
+		{
+			for (auto i = 0; i < _count; i++)
+				_words[i] = (_words[i] >> 1) | (i + 1 < _count ? _words[i + 1] << 31 : 0);
+
+			if (_count > 0 && _words[_count - 1] == 0)
+				_count--;
+		}
+
+		void SetBit(int index)
+		{
+			auto word = index / 32;
+
+			while (_count <= word)
+				_words[_count++] = 0;
+
+			_words[word] |= 1u << (index % 32);
+		}
+
+		auto Compare(const BigInteger& other) const -> int
+		{
+			if (_count != other._count)
+				return _count < other._count ? -1 : 1;
+
+			for (auto i = _count - 1; i >= 0; i--)
+			{
+				if (_words[i] != other._words[i])
+					return _words[i] < other._words[i] ? -1 : 1;
+			}
+
+			return 0;
+		}
+
+		void Subtract(const BigInteger& other)
+		{
+			// other must not be greater than this
+
+			int64_t borrow = 0;
+
+			for (auto i = 0; i < _count; i++)
+			{
+				auto difference = static_cast<int64_t>(_words[i]) - (i < other._count ? other._words[i] : 0) - borrow;
+				borrow = difference < 0 ? 1 : 0;
+				_words[i] = static_cast<uint32_t>(difference + (borrow << 32));
+			}
+
+			while (_count > 0 && _words[_count - 1] == 0)
+				_count--;
+		}
+
+		auto Divide(uint32_t divisor) -> uint32_t
+		{
+			uint64_t remainder = 0;
+
+			for (auto i = _count - 1; i >= 0; i--)
+			{
+				auto current = (remainder << 32) | _words[i];
+				_words[i] = static_cast<uint32_t>(current / divisor);
+				remainder = current % divisor;
+			}
+
+			while (_count > 0 && _words[_count - 1] == 0)
+				_count--;
+
+			return static_cast<uint32_t>(remainder);
+		}
+
+		auto Divide(BigInteger divisor) -> BigInteger
+		{
+			// shift and subtract long division - this is left holding the remainder
+
+			BigInteger quotient(0);
+
+			auto shift = BitLength() - divisor.BitLength();
+
+			if (shift < 0)
+				return quotient;
+
+			divisor.ShiftLeft(shift);
+
+			for (auto bit = shift; bit >= 0; bit--)
+			{
+				if (Compare(divisor) >= 0)
+				{
+					Subtract(divisor);
+					quotient.SetBit(bit);
+				}
+
+				divisor.ShiftRightOne();
+			}
+
+			return quotient;
+		}
+
+	private:
+		uint32_t _words[Capacity + 1];
+		int _count;
+	};
+}
+
+auto Pargon::FormatScaledDecimal(double value, int scale, char* output) -> int
+{
+	// writes the digits of value * 10^scale rounded to an integer with ties going to even - value must be finite and
+	// not negative and the result has no leading zeros
+
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	auto biased = static_cast<int>((bits >> 52) & 0x7FF);
+	auto significand = bits & 0xFFFFFFFFFFFFFull;
+	auto exponent = biased == 0 ? -1074 : biased - 1075;
+
+	if (biased != 0)
+		significand |= 1ull << 52;
+
+	BigInteger numerator(significand);
+	BigInteger denominator(1);
+
+	if (scale >= 0)
+		numerator.MultiplyByPowerOfTen(scale);
+	else
+		denominator.MultiplyByPowerOfTen(-scale);
+
+	if (exponent >= 0)
+		numerator.ShiftLeft(exponent);
+	else
+		denominator.ShiftLeft(-exponent);
+
+	auto quotient = numerator.Divide(denominator);
+
+	numerator.ShiftLeft(1);
+	auto half = numerator.Compare(denominator);
+
+	if (half > 0 || (half == 0 && quotient.IsOdd()))
+		quotient.Add(1);
+
+	// nine digits at a time from the lowest - every chunk but the last is zero padded
+
+	char digits[BigInteger::Capacity * 10];
+	auto cursor = digits + sizeof(digits);
+
+	do
+	{
+		auto chunk = quotient.Divide(1000000000u);
+
+		for (auto i = 0; i < 9 && (chunk != 0 || !quotient.IsZero()); i++, chunk /= 10)
+			*--cursor = static_cast<char>('0' + chunk % 10);
+	}
+	while (!quotient.IsZero());
+
+	if (cursor == digits + sizeof(digits))
+		*--cursor = '0';
+
+	auto length = static_cast<int>(digits + sizeof(digits) - cursor);
+	std::memcpy(output, cursor, length);
+	return length;
+}
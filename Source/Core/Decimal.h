@@ -0,0 +1,6 @@
+#pragma once
+
+namespace Pargon
+{
+	auto FormatScaledDecimal(double value, int scale, char* output) -> int;
+}
@@ -0,0 +1,133 @@
+#include "Pargon/Serialization/DeferredLog.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Pargon;
+
+DeferredLog::DeferredLog(Output output, int capacity) :
+	_output(std::move(output)),
+	_capacity(std::max(capacity, static_cast<int>(sizeof(Header)))),
+	_head(0),
+	_tail(0),
+	_dropped(0),
+	_sleeping(false)
+{
+	_ring = std::make_unique<uint8_t[]>(_capacity);
+	_record = std::make_unique<uint8_t[]>(_capacity);
+	_thread = std::thread(&DeferredLog::Work, this);
+}
+
+DeferredLog::~DeferredLog()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+
+	_wake.notify_one();
+	_thread.join();
+}
+
+void DeferredLog::Flush()
+{
+	auto target = _head.load(std::memory_order_relaxed);
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_wake.notify_one();
+	_drained.wait(lock, [&] { return _tail.load(std::memory_order_acquire) >= target; });
+}
+
+auto DeferredLog::Commit(Decoder decode, const void* format) -> bool
+{
+	// only the logging thread moves _head and only the background thread moves _tail so a record is published with a
+	// single release store - the logging thread never waits and drops the record if there is no room for it
+
+	auto arguments = _arguments.GetBuffer();
+	auto header = Header{ arguments.Size(), decode, format };
+	auto size = static_cast<long long>(sizeof(Header)) + arguments.Size();
+
+	auto head = _head.load(std::memory_order_relaxed);
+	auto tail = _tail.load(std::memory_order_acquire);
+
+	if (_capacity - (head - tail) < size)
+	{
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	CopyIn(head, std::addressof(header), sizeof(Header));
+	CopyIn(head + sizeof(Header), arguments.begin(), arguments.Size());
+
+	_head.store(head + size, std::memory_order_release);
+
+	// the fence pairs with the one in Work so either the background thread sees the new head before it sleeps or this
+	// sees that it is asleep - the lock is only taken to wake it, which happens when the ring was empty
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (_sleeping.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_wake.notify_one();
+	}
+
+	return true;
+}
+
+void DeferredLog::CopyIn(long long position, const void* data, int size)
+{
+	auto offset = static_cast<int>(position % _capacity);
+	auto first = std::min(size, _capacity - offset);
+
+	std::memcpy(_ring.get() + offset, data, first);
+	std::memcpy(_ring.get(), static_cast<const uint8_t*>(data) + first, size - first);
+}
+
+void DeferredLog::CopyOut(long long position, void* data, int size) const
+{
+	auto offset = static_cast<int>(position % _capacity);
+	auto first = std::min(size, _capacity - offset);
+
+	std::memcpy(data, _ring.get() + offset, first);
+	std::memcpy(static_cast<uint8_t*>(data) + first, _ring.get(), size - first);
+}
+
+void DeferredLog::Work()
+{
+	auto tail = _tail.load(std::memory_order_relaxed);
+	BufferReader reader({ _record.get(), 0 });
+
+	while (true)
+	{
+		auto head = _head.load(std::memory_order_acquire);
+
+		while (tail != head)
+		{
+			Header header;
+			CopyOut(tail, std::addressof(header), sizeof(Header));
+			CopyOut(tail + sizeof(Header), _record.get(), header.Size);
+
+			reader.Rebind({ _record.get(), header.Size });
+			header.Decode(header.Format, reader, _line);
+
+			_output(_line.GetString());
+			_line.Reset();
+
+			tail += sizeof(Header) + header.Size;
+			_tail.store(tail, std::memory_order_release);
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_drained.notify_all();
+
+		if (_stopping && _head.load(std::memory_order_acquire) == tail)
+			break;
+
+		_sleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		_wake.wait(lock, [&] { return _stopping || _head.load(std::memory_order_acquire) != tail; });
+		_sleeping.store(false, std::memory_order_relaxed);
+	}
+}
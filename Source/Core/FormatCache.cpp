@@ -0,0 +1,126 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/FormatCache.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+using namespace Pargon;
+
+namespace
+{
+	struct Entry
+	{
+		const char* Source;
+		String Text;
+		StringFormat Format;
+	};
+
+	struct Cache
+	{
+		// open addressing on the pointer and length of the format - entries are only added so readers can probe
+		// without locking and the references handed out stay valid for the lifetime of the program
+
+		static constexpr int Slots = FormatCache::Capacity * 2;
+		static constexpr int Mask = Slots - 1;
+
+		std::atomic<Entry*> Entries[Slots] = {};
+		std::atomic<long long> Hits{ 0 };
+		std::atomic<long long> Misses{ 0 };
+		std::atomic<int> Count{ 0 };
+		std::mutex Insert;
+
+		// entries are deliberately leaked so a format found here can still be used while other statics are destroyed
+	};
+
+	static_assert((Cache::Slots & Cache::Mask) == 0, "the format cache slot count must be a power of two");
+
+	auto GetCache() -> Cache&
+	{
+		static Cache cache;
+		return cache;
+	}
+
+	auto GetSlot(StringView format) -> int
+	{
+		auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(format.begin())) ^ (static_cast<uint64_t>(format.Length()) << 48);
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdull;
+		key ^= key >> 33;
+
+		return static_cast<int>(key & Cache::Mask);
+	}
+
+	auto Matches(const Entry* entry, StringView format) -> bool
+	{
+		return entry->Source == format.begin() && entry->Text.Length() == format.Length() && std::memcmp(entry->Text.begin(), format.begin(), format.Length()) == 0;
+	}
+
+	auto Probe(Cache& cache, StringView format, int& slot) -> Entry*
+	{
+		for (;; slot = (slot + 1) & Cache::Mask)
+		{
+			auto entry = cache.Entries[slot].load(std::memory_order_acquire);
+
+			if (entry == nullptr || Matches(entry, format))
+				return entry;
+		}
+	}
+}
+
+auto FormatCache::Find(StringView format) -> const StringFormat*
+{
+	// returns nullptr once the cache is full so the caller falls back to parsing the format itself
+
+	auto& cache = GetCache();
+	auto slot = GetSlot(format);
+	auto entry = Probe(cache, format, slot);
+
+	if (entry != nullptr)
+	{
+		cache.Hits.fetch_add(1, std::memory_order_relaxed);
+		return &entry->Format;
+	}
+
+	cache.Misses.fetch_add(1, std::memory_order_relaxed);
+
+	// entries are never removed so once the cache is full misses return without contending for the lock
+
+	if (cache.Count.load(std::memory_order_relaxed) >= Capacity)
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock(cache.Insert);
+
+	entry = Probe(cache, format, slot);
+
+	if (entry != nullptr)
+		return &entry->Format;
+
+	if (cache.Count.load(std::memory_order_relaxed) >= Capacity)
+		return nullptr;
+
+	entry = new Entry{ format.begin(), {}, {} };
+	entry->Text.Append(format);
+	entry->Format = ParseFormatString(entry->Text);
+
+	cache.Entries[slot].store(entry, std::memory_order_release);
+	cache.Count.fetch_add(1, std::memory_order_relaxed);
+
+	return &entry->Format;
+}
+
+auto FormatCache::Hits() -> long long
+{
+	return GetCache().Hits.load(std::memory_order_relaxed);
+}
+
+auto FormatCache::Misses() -> long long
+{
+	return GetCache().Misses.load(std::memory_order_relaxed);
+}
+
+auto FormatCache::Count() -> int
+{
+	return GetCache().Count.load(std::memory_order_relaxed);
+}
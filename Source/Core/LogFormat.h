@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pargon
+{
+	struct LogFormat
+	{
+		// block layout
+		// sync marker (8 bytes)
+		// crc32c of everything after the checksum (4 bytes)
+		// payload size (4 bytes)
+		// record count (4 bytes)
+		// number of the first record (8 bytes)
+		// payload: each record is a 4 byte length followed by its bytes
+
+		static constexpr uint8_t SyncMarker[8] = { 0xF7, 'P', 'L', 'O', 'G', 0x0D, 0x0A, 0x1A };
+		static constexpr int SyncSize = 8;
+		static constexpr int ChecksumOffset = 8;
+		static constexpr int ChecksummedOffset = 12;
+		static constexpr int PayloadSizeOffset = 12;
+		static constexpr int RecordCountOffset = 16;
+		static constexpr int HeaderSize = 28;
+	};
+}
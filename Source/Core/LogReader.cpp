@@ -0,0 +1,185 @@
+#include "Pargon/Serialization/LogReader.h"
+#include "Core/Checksum.h"
+#include "Core/LogFormat.h"
+
+#include <cstring>
+
+using namespace Pargon;
+
+LogReader::LogReader(BufferView log) :
+	_data(log.begin()),
+	_length(log.Size())
+{
+}
+
+auto LogReader::ReadBytes(BufferView& record) -> bool
+{
+	while (_recordsLeft == 0)
+	{
+		Block block;
+		auto skipped = 0;
+		auto found = FindBlock(_nextBlock, block, skipped);
+
+		_skipped += skipped;
+
+		if (!found)
+		{
+			_nextBlock = _length;
+			return false;
+		}
+
+		EnterBlock(block);
+	}
+
+	BufferReader reader(_payload);
+	reader.SetEndian(NativeEndian);
+	reader.MoveTo(_payloadIndex);
+
+	// a block whose records don't fit its payload is abandoned so the next call moves on to the following block
+
+	int length;
+	reader.Read(length);
+	record = reader.ReadBytes(length);
+
+	if (reader.HasFailed())
+	{
+		_recordsLeft = 0;
+		return false;
+	}
+
+	_payloadIndex = reader.Index();
+	_recordsLeft--;
+	_recordNumber++;
+	return true;
+}
+
+void LogReader::BuildIndex()
+{
+	_index.Clear();
+
+	auto offset = 0;
+	auto skipped = 0;
+	Block block;
+
+	while (FindBlock(offset, block, skipped))
+	{
+		_index.Add({ block.FirstRecord, block.Offset });
+		offset = block.Offset + LogFormat::HeaderSize + block.Size;
+	}
+}
+
+auto LogReader::Seek(long long record) -> bool
+{
+	if (_index.IsEmpty())
+		BuildIndex();
+
+	auto low = 0;
+	auto high = _index.Count() - 1;
+	auto found = -1;
+
+	while (low <= high)
+	{
+		auto middle = low + (high - low) / 2;
+
+		if (_index.Item(middle).FirstRecord <= record)
+		{
+			found = middle;
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+
+	Block block;
+	if (found < 0 || !ParseBlock(_index.Item(found).Offset, block))
+		return false;
+
+	EnterBlock(block);
+
+	while (_recordNumber < record)
+	{
+		BufferView skip;
+		if (!ReadBytes(skip))
+			return false;
+	}
+
+	return _recordNumber == record;
+}
+
+auto LogReader::ParseBlock(int offset, Block& block) const -> bool
+{
+	if (offset < 0 || _length - offset < LogFormat::HeaderSize)
+		return false;
+
+	if (std::memcmp(_data + offset, LogFormat::SyncMarker, LogFormat::SyncSize) != 0)
+		return false;
+
+	BufferReader reader({ _data + offset + LogFormat::SyncSize, LogFormat::HeaderSize - LogFormat::SyncSize });
+	reader.SetEndian(NativeEndian);
+
+	auto crc = reader.Read<unsigned int>();
+	auto size = reader.Read<int>();
+	auto count = reader.Read<int>();
+	auto first = reader.Read<long long>();
+
+	if (reader.HasFailed() || size < 0 || count < 0 || first < 0 || size > _length - offset - LogFormat::HeaderSize)
+		return false;
+
+	if (Crc32c(0, _data + offset + LogFormat::ChecksummedOffset, LogFormat::HeaderSize - LogFormat::ChecksummedOffset + size) != crc)
+		return false;
+
+	block.Offset = offset;
+	block.Size = size;
+	block.RecordCount = count;
+	block.FirstRecord = first;
+	block.Payload = { _data + offset + LogFormat::HeaderSize, size };
+	return true;
+}
+
+auto LogReader::FindBlock(int offset, Block& block, int& skipped) const -> bool
+{
+	// a block that is torn or fails its checksum is skipped by scanning forward to the next sync marker
+
+	skipped = 0;
+
+	while (offset < _length)
+	{
+		if (ParseBlock(offset, block))
+			return true;
+
+		auto next = offset + 1;
+
+		while (next < _length)
+		{
+			auto candidate = static_cast<const uint8_t*>(std::memchr(_data + next, LogFormat::SyncMarker[0], _length - next));
+			if (candidate == nullptr)
+			{
+				next = _length;
+				break;
+			}
+
+			next = static_cast<int>(candidate - _data);
+
+			if (_length - next >= LogFormat::SyncSize && std::memcmp(candidate, LogFormat::SyncMarker, LogFormat::SyncSize) == 0)
+				break;
+
+			next++;
+		}
+
+		skipped += next - offset;
+		offset = next;
+	}
+
+	return false;
+}
+
+void LogReader::EnterBlock(const Block& block)
+{
+	_nextBlock = block.Offset + LogFormat::HeaderSize + block.Size;
+	_payload = block.Payload;
+	_payloadIndex = 0;
+	_recordsLeft = block.RecordCount;
+	_recordNumber = block.FirstRecord;
+}
@@ -0,0 +1,86 @@
+#include "Pargon/Serialization/LogWriter.h"
+#include "Core/Checksum.h"
+#include "Core/LogFormat.h"
+
+#include <algorithm>
+
+using namespace Pargon;
+
+namespace
+{
+	void OverwriteInt(BufferWriter& writer, int index, uint32_t value)
+	{
+		writer.OverwriteBytes(index, { reinterpret_cast<const uint8_t*>(std::addressof(value)), sizeof(value) }, true);
+	}
+}
+
+LogWriter::LogWriter(Output output, int blockSize) :
+	_output(std::move(output)),
+	_blockSize(std::max(blockSize, 1))
+{
+	_block.SetEndian(NativeEndian);
+}
+
+LogWriter::~LogWriter()
+{
+	Flush();
+}
+
+void LogWriter::AppendBytes(BufferView record)
+{
+	auto start = BeginRecord();
+	_block.WriteBytes(record, false);
+	EndRecord(start);
+}
+
+void LogWriter::Flush()
+{
+	if (_blockRecords == 0)
+		return;
+
+	auto size = _block.Size() - LogFormat::HeaderSize;
+
+	OverwriteInt(_block, LogFormat::PayloadSizeOffset, static_cast<uint32_t>(size));
+	OverwriteInt(_block, LogFormat::RecordCountOffset, static_cast<uint32_t>(_blockRecords));
+
+	auto block = _block.GetBuffer();
+	auto crc = Crc32c(0, block.begin() + LogFormat::ChecksummedOffset, block.Size() - LogFormat::ChecksummedOffset);
+
+	OverwriteInt(_block, LogFormat::ChecksumOffset, crc);
+
+	_output(_block.GetBuffer());
+	_block.Reset();
+	_blockRecords = 0;
+}
+
+auto LogWriter::BeginRecord() -> int
+{
+	if (_blockRecords == 0)
+	{
+		_block.WriteBytes({ LogFormat::SyncMarker, LogFormat::SyncSize }, false);
+		_block.Write(0u);
+		_block.Write(0);
+		_block.Write(0);
+		_block.Write(_recordCount);
+	}
+
+	auto start = _block.Size();
+	_block.Write(0);
+	return start;
+}
+
+void LogWriter::EndRecord(int start)
+{
+	// a record that ends mid-byte is padded so the next length prefix does not share its last byte
+
+	_block.Realign(false);
+
+	auto length = _block.Size() - start - static_cast<int>(SerializationTraits::NormalizedSize<int>);
+	OverwriteInt(_block, start, static_cast<uint32_t>(length));
+
+	_blockRecords++;
+	_recordCount++;
+
+	if (_block.Size() - LogFormat::HeaderSize >= _blockSize)
+		Flush();
+}
@@ -0,0 +1,94 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/Pattern.h"
+
+#include <locale>
+#include <memory>
+#include <regex>
+
+using namespace Pargon;
+
+struct Pattern::Expression
+{
+	std::regex Regex;
+};
+
+namespace
+{
+	auto IsLiteral(StringView pattern) -> bool
+	{
+		return IndexOfAny(pattern, "^$\\.*+?()[]{}|") == String::InvalidIndex;
+	}
+
+	struct Cache
+	{
+		std::unique_ptr<Pattern> Entries[Pattern::CacheCapacity];
+		int Next = 0;
+	};
+}
+
+auto Pattern::Cached(StringView pattern, bool ignoreCase) -> const Pattern&
+{
+	// a small per thread cache so concurrent readers never contend - entries are replaced oldest first
+
+	thread_local Cache cache;
+
+	for (auto& entry : cache.Entries)
+	{
+		if (entry && entry->_ignoreCase == ignoreCase && entry->_text.Length() == pattern.Length() && Equals(entry->_text, pattern, false))
+			return *entry;
+	}
+
+	auto& entry = cache.Entries[cache.Next];
+	cache.Next = (cache.Next + 1) % CacheCapacity;
+	entry = std::make_unique<Pattern>(pattern, ignoreCase);
+	return *entry;
+}
+
+Pattern::Pattern(StringView pattern, bool ignoreCase) :
+	_text(pattern),
+	_ignoreCase(ignoreCase),
+	_isLiteral(::IsLiteral(pattern))
+{
+	// literal patterns skip the regex entirely and are matched with the plain string searches - the regex uses the
+	// classic locale so ignoring case folds the same ascii letters as the string searches do
+
+	if (!_isLiteral)
+	{
+		std::regex::flag_type flags = ignoreCase ? std::regex_constants::icase | std::regex_constants::ECMAScript : std::regex_constants::ECMAScript;
+
+		auto expression = std::make_shared<Expression>();
+		expression->Regex.imbue(std::locale::classic());
+		expression->Regex.assign(pattern.begin(), pattern.end(), flags);
+		_expression = std::move(expression);
+	}
+}
+
+auto Pattern::Search(StringView text) const -> int
+{
+	// returns the position of the first match in text or -1 if there isn't one
+
+	if (_isLiteral)
+		return _text.Length() == 0 ? 0 : IndexOf(text, _text, _ignoreCase);
+
+	std::cmatch match;
+
+	if (!std::regex_search(text.begin(), text.end(), match, _expression->Regex))
+		return -1;
+
+	return static_cast<int>(match.position(0));
+}
+
+auto Pattern::Match(StringView text) const -> int
+{
+	// returns the length of the match at the start of text or -1 if there isn't one
+
+	if (_isLiteral)
+		return StartsWith(text, _text, _ignoreCase) ? _text.Length() : -1;
+
+	std::cmatch match;
+
+	if (!std::regex_search(text.begin(), text.end(), match, _expression->Regex, std::regex_constants::match_continuous))
+		return -1;
+
+	return static_cast<int>(match.length(0));
+}
@@ -0,0 +1,153 @@
+#include "Core/Scan.h"
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PARGON_SCAN_SSE2
+	#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+using namespace Pargon;
+
+namespace
+{
+	auto CountTrailingZeros(unsigned int mask) -> int
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	auto IsEscapeCharacter(char character) -> bool
+	{
+		return static_cast<unsigned char>(character) < 0x20 || character == '"' || character == '\\';
+	}
+}
+
+auto Pargon::FindEscapeCharacter(const char* begin, const char* end) -> const char*
+{
+	// finds the first quote, backslash, or control character - a byte is a control character when raising it to at
+	// least 0x1F leaves it unchanged
+
+	auto cursor = begin;
+
+#if defined(__AVX2__)
+	auto quote = _mm256_set1_epi8('"');
+	auto backslash = _mm256_set1_epi8('\\');
+	auto control = _mm256_set1_epi8(0x1F);
+
+	for (; end - cursor >= 32; cursor += 32)
+	{
+		auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor));
+		auto matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote), _mm256_cmpeq_epi8(bytes, backslash)), _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, control), control));
+		auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(matches));
+
+		if (mask != 0)
+			return cursor + CountTrailingZeros(mask);
+	}
+#elif defined(PARGON_SCAN_SSE2)
+	auto quote = _mm_set1_epi8('"');
+	auto backslash = _mm_set1_epi8('\\');
+	auto control = _mm_set1_epi8(0x1F);
+
+	for (; end - cursor >= 16; cursor += 16)
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+		auto matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)), _mm_cmpeq_epi8(_mm_max_epu8(bytes, control), control));
+		auto mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+
+		if (mask != 0)
+			return cursor + CountTrailingZeros(mask);
+	}
+#endif
+
+	while (cursor < end && !IsEscapeCharacter(*cursor))
+		cursor++;
+
+	return cursor;
+}
+
+auto Pargon::FindQuoteOrBackslash(const char* begin, const char* end) -> const char*
+{
+	// finds the first quote or backslash - unlike FindEscapeCharacter control characters are skipped
+
+	auto cursor = begin;
+
+#if defined(__AVX2__)
+	auto quote = _mm256_set1_epi8('"');
+	auto backslash = _mm256_set1_epi8('\\');
+
+	for (; end - cursor >= 32; cursor += 32)
+	{
+		auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor));
+		auto matches = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote), _mm256_cmpeq_epi8(bytes, backslash));
+		auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(matches));
+
+		if (mask != 0)
+			return cursor + CountTrailingZeros(mask);
+	}
+#elif defined(PARGON_SCAN_SSE2)
+	auto quote = _mm_set1_epi8('"');
+	auto backslash = _mm_set1_epi8('\\');
+
+	for (; end - cursor >= 16; cursor += 16)
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+		auto matches = _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash));
+		auto mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+
+		if (mask != 0)
+			return cursor + CountTrailingZeros(mask);
+	}
+#endif
+
+	while (cursor < end && *cursor != '"' && *cursor != '\\')
+		cursor++;
+
+	return cursor;
+}
+
+void Pargon::FindNewlines(const char* begin, const char* end, int offset, List<int>& newlines)
+{
+	// adds the position of each '\n', plus offset, to newlines
+
+	auto cursor = begin;
+
+#if defined(__AVX2__)
+	auto newline = _mm256_set1_epi8('\n');
+
+	for (; end - cursor >= 32; cursor += 32)
+	{
+		auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor));
+		auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline)));
+
+		for (; mask != 0; mask &= mask - 1)
+			newlines.Add(offset + static_cast<int>(cursor - begin) + CountTrailingZeros(mask));
+	}
+#elif defined(PARGON_SCAN_SSE2)
+	auto newline = _mm_set1_epi8('\n');
+
+	for (; end - cursor >= 16; cursor += 16)
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+		auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)));
+
+		for (; mask != 0; mask &= mask - 1)
+			newlines.Add(offset + static_cast<int>(cursor - begin) + CountTrailingZeros(mask));
+	}
+#endif
+
+	for (; cursor < end; cursor++)
+	{
+		if (*cursor == '\n')
+			newlines.Add(offset + static_cast<int>(cursor - begin));
+	}
+}
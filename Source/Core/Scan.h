@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Pargon/Containers/List.h"
+
+namespace Pargon
+{
+	auto FindEscapeCharacter(const char* begin, const char* end) -> const char*;
+	auto FindQuoteOrBackslash(const char* begin, const char* end) -> const char*;
+	void FindNewlines(const char* begin, const char* end, int offset, List<int>& newlines);
+}
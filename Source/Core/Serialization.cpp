@@ -87,6 +87,44 @@ namespace
 	void ParseSpecification(TokenType& token, IteratorType begin, IteratorType end)
 	{
 		token.Specification = GetView(begin, end);
+		token.Number = ParseNumberFormat(token.Specification.begin(), token.Specification.Length());
+	}
+
+	template<typename IteratorType>
+	void ReadToken(IteratorType& cursor, IteratorType end, int& nextIndex, FormatToken& token)
+	{
+		// reads the token at cursor, which must not be end - an unterminated parameter runs to the end of the format
+
+		token = {};
+
+		auto open = FindLiteralEnd(cursor, end);
+
+		if (cursor != open)
+		{
+			token.ParameterIndex = FormatToken::NoParameter;
+			token.Specification = GetView(cursor, open);
+			cursor = open;
+		}
+		else if (IsLiteralBrace(open, end))
+		{
+			token.ParameterIndex = FormatToken::NoParameter;
+			token.Specification = GetView(cursor, cursor + 1);
+			cursor += 2;
+		}
+		else
+		{
+			cursor = open + 1;
+
+			auto id = FindIdEnd(cursor, end);
+			auto specification = id == end || *id == '}' ? id : FindSpecificationEnd(id + 1, end);
+
+			ParseId(token, cursor, id, nextIndex);
+
+			if (id != end && *id == '|')
+				ParseSpecification(token, id + 1, specification);
+
+			cursor = specification == end ? end : specification + 1;
+		}
 	}
 
 	template<typename FormatType, typename ViewType>
@@ -99,44 +137,35 @@ namespace
 		auto end = format.end();
 
 		while (cursor != end)
-		{
-			auto open = FindLiteralEnd(cursor, end);
-
-			if (cursor != open)
-			{
-				auto& token = tokens.Tokens.Increment();
-				token.ParameterIndex = FormatToken::NoParameter;
-				token.Specification = GetView(cursor, open);
-
-				cursor = open;
-			}
+			ReadToken(cursor, end, nextIndex, tokens.Tokens.Increment());
 
-			if (IsLiteralBrace(open, end))
-			{
-				auto& token = tokens.Tokens.Increment();
-				token.ParameterIndex = FormatToken::NoParameter;
-				token.Specification = GetView(cursor, cursor + 1);
-				cursor += 2;
-			}
-			else if (open != end)
-			{
-				cursor = open + 1;
+		return tokens;
+	}
 
-				auto id = FindIdEnd(cursor, end);
-				auto specification = id == end || *id == '}' ? id : FindSpecificationEnd(id + 1, end);
+	template<typename FormatType>
+	auto Bind(FormatType& format, SequenceView<StringView> names) -> bool
+	{
+		// named tokens become indices into names so they can be dispatched like indexed parameters - the arguments must be
+		// passed in the same order as names
 
-				auto& token = tokens.Tokens.Increment();
+		auto bound = true;
 
-				ParseId(token, cursor, id, nextIndex);
+		for (auto& token : format.Tokens)
+		{
+			if (token.ParameterIndex != FormatToken::NamedParameter)
+				continue;
 
-				if (*id == '|')
-					ParseSpecification(token, id + 1, specification);
+			auto index = 0;
+			while (index < names.Count() && !Equals(names.Item(index), token.ParameterName))
+				index++;
 
-				cursor = specification + 1;
-			}
+			if (index < names.Count())
+				token.ParameterIndex = index;
+			else
+				bound = false;
 		}
 
-		return tokens;
+		return bound;
 	}
 }
 
@@ -145,7 +174,29 @@ auto Pargon::ParseFormatString(StringView format) -> StringFormat
 	return ParseFormat<StringFormat>(format);
 }
 
+auto Pargon::ReadFormatToken(StringView format, int& cursor, int& nextIndex, FormatToken& token) -> bool
+{
+	if (cursor >= format.Length())
+		return false;
+
+	auto position = format.begin() + cursor;
+	ReadToken(position, format.end(), nextIndex, token);
+	cursor = static_cast<int>(position - format.begin());
+
+	return true;
+}
+
 auto Pargon::ParseFormatText(TextView format) -> TextFormat
 {
 	return ParseFormat<TextFormat>(format);
 }
+
+auto Pargon::BindFormat(StringFormat& format, SequenceView<StringView> names) -> bool
+{
+	return Bind(format, names);
+}
+
+auto Pargon::BindFormat(TextFormat& format, SequenceView<StringView> names) -> bool
+{
+	return Bind(format, names);
+}
@@ -3,12 +3,28 @@
 #include "Pargon/Containers/String.h"
 #include "Pargon/Serialization/StringReader.h"
 #include "Pargon/Serialization/BlueprintReader.h"
+#include "Core/Base64.h"
+#include "Core/Scan.h"
 
 #include <rapidjson/document.h>
-#include <regex>
+#include <rapidjson/internal/biginteger.h>
+#include <rapidjson/internal/strtod.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 using namespace Pargon;
 
+namespace
+{
+	constexpr CharacterSet WhitespaceCharacters(" \t\r\n");
+	constexpr CharacterSet PonNameEnd(" \t\r\n=:[{");
+	constexpr CharacterSet PonValueEnd("\r\n\t ]}");
+}
+
 StringReader::StringReader(StringView text) :
 	_data(text.begin()),
 	_length(text.Length()),
@@ -16,24 +32,43 @@ StringReader::StringReader(StringView text) :
 {
 }
 
+void StringReader::Rebind(StringView text)
+{
+	_data = text.begin();
+	_length = text.Length();
+	_index = 0;
+	_hasFailed = false;
+	_errors.Clear();
+	_newlines.Clear();
+	_newlinesEnd = 0;
+}
+
 void StringReader::ReportError(StringView message)
 {
-	auto line = 1;
-	auto column = 1;
+	int line, column;
+	GetLocation(_index, line, column);
 
-	for (auto i = 0; i < _index; ++i)
-	{
-		++column;
+	_hasFailed = true;
+	_errors.Add({ line, column, message });
+}
 
-		if (_data[i] == '\n')
-		{
-			++line;
-			column = 1;
-		}
+void StringReader::GetLocation(int index, int& line, int& column) const
+{
+	// newlines are found on demand up to the furthest index asked about so far and the line is found by binary search
+
+	index = std::max(0, std::min(index, _length));
+
+	if (index > _newlinesEnd)
+	{
+		FindNewlines(_data + _newlinesEnd, _data + index, _newlinesEnd, _newlines);
+		_newlinesEnd = index;
 	}
 
-	_hasFailed = true;
-	_errors.Add({ line, column, message });
+	auto previous = static_cast<int>(std::lower_bound(_newlines.begin(), _newlines.end(), index) - _newlines.begin());
+	auto lineStart = previous > 0 ? _newlines.Item(previous - 1) + 1 : 0;
+
+	line = previous + 1;
+	column = index - lineStart + 1;
 }
 
 auto StringReader::ViewTo(int count) const -> StringView
@@ -119,10 +154,15 @@ auto StringReader::AdvanceTo(StringView string, bool ignoreCase) -> int
 
 auto StringReader::AdvanceToWhitespace() -> int
 {
-	return AdvanceToAny(" \t\r\n", false);
+	return AdvanceToAny(WhitespaceCharacters);
 }
 
 auto StringReader::AdvanceToAny(StringView characters, bool ignoreCase) -> int
+{
+	return AdvanceToAny(CharacterSet(characters, ignoreCase));
+}
+
+auto StringReader::AdvanceToAny(const CharacterSet& characters) -> int
 {
 	auto index = IndexOfAny(ViewRemaining(), characters);
 	if (index != String::InvalidIndex)
@@ -133,15 +173,15 @@ auto StringReader::AdvanceToAny(StringView characters, bool ignoreCase) -> int
 
 auto StringReader::AdvanceToExpression(StringView pattern, bool ignoreCase) -> int
 {
-	std::cmatch match;
-	std::regex::flag_type flags = ignoreCase ? std::regex_constants::icase | std::regex_constants::ECMAScript : std::regex_constants::ECMAScript;
-	auto regex = std::regex(pattern.begin(), pattern.end(), flags);
+	return AdvanceToExpression(Pattern::Cached(pattern, ignoreCase));
+}
 
-	if (!std::regex_search(_data + _index, _data + _length, match, regex))
-		return -1;
+auto StringReader::AdvanceToExpression(const Pattern& pattern) -> int
+{
+	auto position = pattern.Search({ _data + _index, _length - _index });
+	if (position != -1)
+		_index += position;
 
-	auto position = static_cast<int>(match.position(0));
-	_index += position;
 	return position;
 }
 
@@ -156,12 +196,17 @@ auto StringReader::AdvancePast(StringView string, bool ignoreCase) -> int
 
 auto StringReader::AdvancePastWhitespace() -> int
 {
-	return AdvancePastAny(" \t\r\n", false);
+	return AdvancePastAny(WhitespaceCharacters);
 }
 
 auto StringReader::AdvancePastAny(StringView characters, bool ignoreCase) -> int
 {
-	auto index = IndexOfAnyOther(ViewRemaining(), characters, ignoreCase);
+	return AdvancePastAny(CharacterSet(characters, ignoreCase));
+}
+
+auto StringReader::AdvancePastAny(const CharacterSet& characters) -> int
+{
+	auto index = IndexOfAnyOther(ViewRemaining(), characters);
 	if (index == String::InvalidIndex)
 		index = _length - _index;
 
@@ -171,15 +216,15 @@ auto StringReader::AdvancePastAny(StringView characters, bool ignoreCase) -> int
 
 auto StringReader::AdvancePastExpression(StringView pattern, bool ignoreCase) -> int
 {
-	std::cmatch match;
-	std::regex::flag_type flags = ignoreCase ? std::regex_constants::icase | std::regex_constants::ECMAScript : std::regex_constants::ECMAScript;
-	auto regex = std::regex(pattern.begin(), pattern.end(), flags);
+	return AdvancePastExpression(Pattern::Cached(pattern, ignoreCase));
+}
 
-	if (!std::regex_search(_data + _index, _data + _length, match, regex, std::regex_constants::match_continuous))
-		return -1;
+auto StringReader::AdvancePastExpression(const Pattern& pattern) -> int
+{
+	auto length = pattern.Match({ _data + _index, _length - _index });
+	if (length != -1)
+		_index += length;
 
-	auto length = static_cast<int>(match.length(0));
-	_index += length;
 	return length;
 }
 
@@ -194,10 +239,15 @@ auto StringReader::RetreatTo(StringView string, bool ignoreCase) -> int
 
 auto StringReader::RetreatToWhitespace() -> int
 {
-	return RetreatToAny(" \t\r\n", false);
+	return RetreatToAny(WhitespaceCharacters);
 }
 
 auto StringReader::RetreatToAny(StringView characters, bool ignoreCase) -> int
+{
+	return RetreatToAny(CharacterSet(characters, ignoreCase));
+}
+
+auto StringReader::RetreatToAny(const CharacterSet& characters) -> int
 {
 	auto index = LastIndexOfAny({ _data, _index }, characters);
 	if (index != String::InvalidIndex)
@@ -208,15 +258,15 @@ auto StringReader::RetreatToAny(StringView characters, bool ignoreCase) -> int
 
 auto StringReader::RetreatToExpression(StringView pattern, bool ignoreCase) -> int
 {
-	std::cmatch match;
-	std::regex::flag_type flags = ignoreCase ? std::regex_constants::icase | std::regex_constants::ECMAScript : std::regex_constants::ECMAScript;
-	auto regex = std::regex(pattern.begin(), pattern.end(), flags);
+	return RetreatToExpression(Pattern::Cached(pattern, ignoreCase));
+}
 
-	if (!std::regex_search(_data, _data + _index, match, regex))
-		return -1;
+auto StringReader::RetreatToExpression(const Pattern& pattern) -> int
+{
+	auto position = pattern.Search({ _data, _index });
+	if (position != -1)
+		_index = position;
 
-	auto position = static_cast<int>(match.position(0));
-	_index = position;
 	return position;
 }
 
@@ -231,12 +281,17 @@ auto StringReader::RetreatPast(StringView string, bool ignoreCase) -> int
 
 auto StringReader::RetreatPastWhitespace() -> int
 {
-	return RetreatPastAny(" \t\r\n", false);
+	return RetreatPastAny(WhitespaceCharacters);
 }
 
 auto StringReader::RetreatPastAny(StringView characters, bool ignoreCase) -> int
 {
-	auto index = LastIndexOfAnyOther({ _data, _index }, characters, ignoreCase);
+	return RetreatPastAny(CharacterSet(characters, ignoreCase));
+}
+
+auto StringReader::RetreatPastAny(const CharacterSet& characters) -> int
+{
+	auto index = LastIndexOfAnyOther({ _data, _index }, characters);
 	if (index != String::InvalidIndex)
 		_index = index;
 
@@ -245,29 +300,344 @@ auto StringReader::RetreatPastAny(StringView characters, bool ignoreCase) -> int
 
 auto StringReader::RetreatPastExpression(StringView pattern, bool ignoreCase) -> int
 {
-	std::cmatch match;
-	std::regex::flag_type flags = ignoreCase ? std::regex_constants::icase | std::regex_constants::ECMAScript : std::regex_constants::ECMAScript;
-	auto regex = std::regex(pattern.begin(), pattern.end(), flags);
+	return RetreatPastExpression(Pattern::Cached(pattern, ignoreCase));
+}
 
-	if (!std::regex_search(_data, _data + _index, match, regex, std::regex_constants::match_continuous))
-		return -1;
+auto StringReader::RetreatPastExpression(const Pattern& pattern) -> int
+{
+	auto length = pattern.Match({ _data, _index });
+	if (length != -1)
+		_index = length;
 
-	auto length = static_cast<int>(match.length(0));
-	_index = length;
 	return length;
 }
 
 namespace
 {
+	// the most significant digits kept when parsing a rational - rapidjson's strtod drops any past this as well
+
+	constexpr int MaximumRationalDigits = 780;
+
+	auto SkipSpace(const char* cursor, const char* end) -> const char*
+	{
+		while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n' || *cursor == '\v' || *cursor == '\f'))
+			cursor++;
+
+		return cursor;
+	}
+
+	auto SkipWord(const char* cursor, const char* end, const char* word) -> const char*
+	{
+		// returns nullptr if the characters at cursor are not word, ignoring case
+
+		for (; *word != '\0'; cursor++, word++)
+		{
+			if (cursor == end || (*cursor | 0x20) != *word)
+				return nullptr;
+		}
+
+		return cursor;
+	}
+
+	auto HexadecimalValue(char character) -> int
+	{
+		if (character >= '0' && character <= '9') return character - '0';
+		if (character >= 'a' && character <= 'f') return character - 'a' + 10;
+		if (character >= 'A' && character <= 'F') return character - 'A' + 10;
+		return -1;
+	}
+
+	auto ParseInteger(const char* begin, const char* end, bool& negative, uint64_t& magnitude) -> const char*
+	{
+		// formats
+		// [sign]digits -> decimal
+		// [sign]0xdigits -> hex
+		// returns begin if there is no number and nullptr if it does not fit in 64 bits
+
+		auto cursor = SkipSpace(begin, end);
+
+		negative = false;
+		magnitude = 0;
+
+		if (cursor != end && (*cursor == '+' || *cursor == '-'))
+			negative = *cursor++ == '-';
+
+		auto digits = cursor;
+
+		if (end - cursor > 2 && cursor[0] == '0' && (cursor[1] | 0x20) == 'x' && HexadecimalValue(cursor[2]) >= 0)
+		{
+			for (cursor += 2; cursor != end && HexadecimalValue(*cursor) >= 0; cursor++)
+			{
+				if (magnitude >> 60 != 0)
+					return nullptr;
+
+				magnitude = (magnitude << 4) | static_cast<uint64_t>(HexadecimalValue(*cursor));
+			}
+
+			return cursor;
+		}
+
+		for (; cursor != end && *cursor >= '0' && *cursor <= '9'; cursor++)
+		{
+			auto digit = static_cast<uint64_t>(*cursor - '0');
+
+			if (magnitude > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+				return nullptr;
+
+			magnitude = magnitude * 10 + digit;
+		}
+
+		return cursor == digits ? begin : cursor;
+	}
+
+	auto FitsSigned(bool negative, uint64_t magnitude, uint64_t maximum) -> bool
+	{
+		return magnitude <= maximum + (negative ? 1 : 0);
+	}
+
+	auto ToSigned(bool negative, uint64_t magnitude) -> int64_t
+	{
+		return static_cast<int64_t>(negative ? 0 - magnitude : magnitude);
+	}
+
+	auto CompareDecimal(const char* digits, int length, int exponent, uint64_t significand, int binaryExponent) -> int
+	{
+		// compares digits * 10^exponent with significand * 2^binaryExponent exactly
+
+		using rapidjson::internal::BigInteger;
+
+		BigInteger decimal(digits, length);
+		BigInteger binary(significand);
+
+		if (exponent >= 0)
+			decimal.MultiplyPow5(static_cast<unsigned>(exponent)) <<= static_cast<std::size_t>(exponent);
+		else
+			binary.MultiplyPow5(static_cast<unsigned>(-exponent)) <<= static_cast<std::size_t>(-exponent);
+
+		if (binaryExponent >= 0)
+			binary <<= static_cast<std::size_t>(binaryExponent);
+		else
+			decimal <<= static_cast<std::size_t>(-binaryExponent);
+
+		return decimal.Compare(binary);
+	}
+
+	auto NarrowToFloat(const char* digits, int length, int exponent, double magnitude) -> float
+	{
+		// rounding to double first and then to float is only wrong when the double lands exactly halfway between two
+		// floats - the exact digits are compared with that halfway point to pick the side the value is really on
+
+		if (magnitude >= 0x1p128)
+			return std::numeric_limits<float>::infinity();
+
+		auto lower = static_cast<float>(magnitude);
+		if (lower > magnitude)
+			lower = std::nextafter(lower, 0.0f);
+
+		auto upper = lower == std::numeric_limits<float>::max() ? 0x1p128 : static_cast<double>(std::nextafter(lower, std::numeric_limits<float>::infinity()));
+
+		if (length == 0 || (static_cast<double>(lower) + upper) * 0.5 != magnitude)
+			return static_cast<float>(magnitude);
+
+		auto binaryExponent = 0;
+		auto fraction = std::frexp(magnitude, &binaryExponent);
+		auto significand = static_cast<uint64_t>(std::ldexp(fraction, 53));
+		auto comparison = CompareDecimal(digits, length, exponent, significand, binaryExponent - 53);
+
+		if (comparison < 0)
+			return lower;
+
+		if (comparison > 0)
+			return static_cast<float>(upper);
+
+		return static_cast<float>(magnitude);
+	}
+
 	template<typename T>
-	auto ReadNumber(StringReader& reader, T& number, const char* format) -> bool
+	auto ParseRational(const char* begin, const char* end, T& number) -> const char*
 	{
-		int count;
-		auto success = sscanf(reader.ViewRemaining().begin(), format, &number, &count);
-		if (success != 1)
+		// formats
+		// [sign]digits[.digits][e[sign]digits] -> decimal (a number can also start or end with the '.')
+		// [sign]inf or [sign]infinity -> infinity
+		// [sign]nan -> not a number
+		// returns begin if there is no number
+
+		auto cursor = SkipSpace(begin, end);
+		auto negative = false;
+
+		if (cursor != end && (*cursor == '+' || *cursor == '-'))
+			negative = *cursor++ == '-';
+
+		if (auto infinity = SkipWord(cursor, end, "inf"))
+		{
+			auto full = SkipWord(infinity, end, "inity");
+			number = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+			return full != nullptr ? full : infinity;
+		}
+
+		if (auto nan = SkipWord(cursor, end, "nan"))
+		{
+			number = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+			return nan;
+		}
+
+		// the value is digits * 10^exponent where digits has no leading zeros
+
+		char digits[MaximumRationalDigits];
+		auto length = 0;
+		auto exponent = 0;
+		auto hasDigits = false;
+		auto fraction = false;
+
+		for (; cursor != end; cursor++)
+		{
+			if (*cursor == '.' && !fraction)
+			{
+				fraction = true;
+				continue;
+			}
+
+			if (*cursor < '0' || *cursor > '9')
+				break;
+
+			hasDigits = true;
+
+			if (length == 0 && *cursor == '0')
+			{
+				if (fraction)
+					exponent--;
+			}
+			else if (length < MaximumRationalDigits)
+			{
+				digits[length++] = *cursor;
+
+				if (fraction)
+					exponent--;
+			}
+			else if (!fraction)
+			{
+				exponent++;
+			}
+		}
+
+		if (!hasDigits)
+			return begin;
+
+		if (cursor != end && (*cursor | 0x20) == 'e')
+		{
+			auto exponentCursor = cursor + 1;
+			auto exponentNegative = false;
+
+			if (exponentCursor != end && (*exponentCursor == '+' || *exponentCursor == '-'))
+				exponentNegative = *exponentCursor++ == '-';
+
+			if (exponentCursor != end && *exponentCursor >= '0' && *exponentCursor <= '9')
+			{
+				auto explicitExponent = 0;
+
+				for (; exponentCursor != end && *exponentCursor >= '0' && *exponentCursor <= '9'; exponentCursor++)
+				{
+					if (explicitExponent < 100000)
+						explicitExponent = explicitExponent * 10 + (*exponentCursor - '0');
+				}
+
+				exponent += exponentNegative ? -explicitExponent : explicitExponent;
+				cursor = exponentCursor;
+			}
+		}
+
+		// rapidjson's strtod is only correct for results in the range of double so values that round to 0 or to infinity
+		// are found first - the boundaries are half of the smallest denormal and halfway between the largest double and
+		// 2^1024, both of which round away from the odd neighbour
+
+		auto magnitude = 0.0;
+		auto decimalExponent = length + exponent - 1;
+
+		if (length == 0 || decimalExponent < -325 || (decimalExponent <= -323 && CompareDecimal(digits, length, exponent, 1, -1075) <= 0))
+		{
+			magnitude = 0.0;
+		}
+		else if (decimalExponent > 308 || (decimalExponent == 308 && CompareDecimal(digits, length, exponent, (1ull << 54) - 1, 970) >= 0))
+		{
+			magnitude = std::numeric_limits<double>::infinity();
+		}
+		else
+		{
+			// the leading digits give the approximation rapidjson starts from - it is only used directly when every
+			// digit fits so it is exact
+
+			uint64_t significand = 0;
+			auto leading = length < 19 ? length : 19;
+
+			for (auto i = 0; i < leading; i++)
+				significand = significand * 10 + static_cast<uint64_t>(digits[i] - '0');
+
+			magnitude = rapidjson::internal::StrtodFullPrecision(static_cast<double>(significand), exponent + length - leading, digits, length, length, exponent);
+		}
+
+		if constexpr (std::is_same<T, float>::value)
+		{
+			auto single = NarrowToFloat(digits, length, exponent, magnitude);
+			number = negative ? -single : single;
+		}
+		else
+		{
+			number = negative ? -magnitude : magnitude;
+		}
+
+		return cursor;
+	}
+
+	template<typename T>
+	auto ReadInteger(StringReader& reader, T& number) -> bool
+	{
+		// fails without moving if the number does not fit in T
+
+		auto text = reader.ViewRemaining();
+		auto negative = false;
+		uint64_t magnitude = 0;
+
+		auto end = ParseInteger(text.begin(), text.end(), negative, magnitude);
+
+		if (end == nullptr || end == text.begin())
 			return false;
 
-		reader.Advance(count);
+		if constexpr (std::is_signed<T>::value)
+		{
+			if (!FitsSigned(negative, magnitude, static_cast<uint64_t>(std::numeric_limits<T>::max())))
+				return false;
+
+			number = static_cast<T>(ToSigned(negative, magnitude));
+		}
+		else
+		{
+			if ((negative && magnitude != 0) || magnitude > std::numeric_limits<T>::max())
+				return false;
+
+			number = static_cast<T>(magnitude);
+		}
+
+		reader.Advance(static_cast<int>(end - text.begin()));
+		return true;
+	}
+
+	template<typename T>
+	auto ReadRational(StringReader& reader, T& number) -> bool
+	{
+		// floats are rounded from the digits directly and long doubles are parsed as a double and widened
+
+		using ParsedType = std::conditional_t<std::is_same<T, float>::value, float, double>;
+
+		auto text = reader.ViewRemaining();
+		auto value = ParsedType(0);
+
+		auto end = ParseRational(text.begin(), text.end(), value);
+
+		if (end == text.begin())
+			return false;
+
+		number = static_cast<T>(value);
+		reader.Advance(static_cast<int>(end - text.begin()));
 		return true;
 	}
 }
@@ -313,79 +683,79 @@ void StringReader::Read_(bool& boolean, StringView format)
 
 void StringReader::Read_(signed char& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%hhi%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(short& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%hi%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(int& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%i%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(long& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%li%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(long long& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%lli%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(unsigned char& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%hhu%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(unsigned short& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%hu%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(unsigned int& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%u%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(unsigned long& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%lu%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(unsigned long long& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%llu%n"))
+	if (!ReadInteger(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(float& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%f%n"))
+	if (!ReadRational(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(double& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%lf%n"))
+	if (!ReadRational(*this, number))
 		ReportError("not a number");
 }
 
 void StringReader::Read_(long double& number, StringView format)
 {
-	if (!ReadNumber(*this, number, "%Lf%n"))
+	if (!ReadRational(*this, number))
 		ReportError("not a number");
 }
 
@@ -426,30 +796,83 @@ void StringReader::Read_(Text& text, StringView format)
 void StringReader::Read_(Buffer& buffer, StringView format)
 {
 	auto string = ViewRemaining();
-	buffer = FromBase64(string);
+	auto length = static_cast<int>(FindBase64End(string.begin(), string.end()) - string.begin());
+
+	// the run may stop at any character since more input can follow it, but a lone digit in the last group cannot
+	// hold a whole byte
+
+	auto digits = length;
+	while (digits > 0 && string.Character(digits - 1) == '=')
+		digits--;
+
+	if (digits % 4 == 1)
+	{
+		ReportError("not base64");
+		return;
+	}
+
+	auto size = Base64DecodedSize(string.begin(), length);
+
+	DecodeBase64(string.begin(), length, static_cast<uint8_t*>(buffer.GetReference(size).begin()));
+	Advance(length);
 }
 
 namespace
 {
 	auto ReadPonString(StringReader& reader, Blueprint& blueprint) -> bool
 	{
-		StringView string;
+		// the character after a backslash never ends the string - strings without one are stored as they are rather
+		// than through an unescaped copy
+
+		auto remaining = reader.ViewRemaining();
+		auto begin = remaining.begin();
+		auto end = remaining.end();
+
+		if (begin == end || *begin != '"')
+		{
+			reader.ReportError("expected a string");
+			return false;
+		}
+
+		auto isEscaped = false;
+		auto cursor = FindQuoteOrBackslash(begin + 1, end);
 
-		if (!reader.Parse("\"{|(?:[^\"\\\\]|\\\\.)*}\"", string))
+		while (cursor != end && *cursor == '\\')
+		{
+			isEscaped = true;
+			cursor = end - cursor >= 2 ? FindQuoteOrBackslash(cursor + 2, end) : end;
+		}
+
+		if (cursor == end)
 		{
 			reader.ReportError("expected a string");
 			return false;
 		}
 
-		auto escaped = Unescaped(string);
-		blueprint.SetToString(escaped);
+		StringView string = { begin + 1, static_cast<int>(cursor - begin - 1) };
+		reader.Advance(static_cast<int>(cursor - begin + 1));
+
+		if (isEscaped)
+			blueprint.SetToString(Unescaped(string));
+		else
+			blueprint.SetToString(string);
+
 		return true;
 	}
 
 	auto ReadPonBoolNullOrNumber(StringReader& reader, Blueprint& blueprint) -> bool
 	{
-		auto count = reader.AdvanceToAny("\r\n\t ]}", false);
-		auto value = reader.ViewPrevious(count).GetString();
+		// the value runs to the end of the input when it is the last thing in it
+
+		auto count = reader.AdvanceToAny(PonValueEnd);
+
+		if (count == String::InvalidIndex)
+		{
+			count = reader.ViewRemaining().Length();
+			reader.Advance(count);
+		}
+
+		auto value = reader.ViewPrevious(count);
 
 		if (Pargon::Equals(value, "true", true))
 		{
@@ -467,33 +890,31 @@ namespace
 		{
 			blueprint.SetToNull();
 		}
-		else if (Pargon::IndexOf(value, ".", false) != String::InvalidIndex)
+		else
 		{
-			double number;
-			StringReader numberReader(value);
-			numberReader.Read(number, {});
+			// anything that is not entirely an integer, including exponents, inf, and nan, is read as a rational
 
-			if (numberReader.HasFailed())
-			{
-				reader.ReportError("expected a number");
-				return false;
-			}
+			auto negative = false;
+			uint64_t magnitude = 0;
+			auto number = 0.0;
 
-			blueprint.SetToFloatingPoint(number);
-		}
-		else
-		{
-			long long number;
-			StringReader numberReader(value);
-			numberReader.Read(number, {});
+			auto integerEnd = ParseInteger(value.begin(), value.end(), negative, magnitude);
+			auto isInteger = !value.IsEmpty() && integerEnd == value.end() && FitsSigned(negative, magnitude, std::numeric_limits<int64_t>::max());
+			auto isRational = !value.IsEmpty() && !isInteger && ParseRational(value.begin(), value.end(), number) == value.end();
 
-			if (numberReader.HasFailed())
+			if (isInteger)
+			{
+				blueprint.SetToInteger(ToSigned(negative, magnitude));
+			}
+			else if (isRational)
+			{
+				blueprint.SetToFloatingPoint(number);
+			}
+			else
 			{
 				reader.ReportError("expected a number");
 				return false;
 			}
-
-			blueprint.SetToInteger(number);
 		}
 
 		return true;
@@ -570,7 +991,7 @@ namespace
 			if (character == '}')
 				break;
 
-			auto count = reader.AdvanceToAny(" \t\r\n=:[{", false);
+			auto count = reader.AdvanceToAny(PonNameEnd);
 			auto name = reader.ViewPrevious(count);
 			auto& child = object.Children.AddOrSet(name, {});
 
@@ -2,38 +2,433 @@
 #include "Pargon/Containers/Buffer.h"
 #include "Pargon/Serialization/BlueprintWriter.h"
 #include "Pargon/Serialization/StringWriter.h"
+#include "Core/Base64.h"
+#include "Core/Decimal.h"
+#include "Core/Scan.h"
 
-#include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/internal/dtoa.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
 
 using namespace Pargon;
 
 namespace
 {
+	constexpr char DecimalPairs[] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+
+	constexpr char HexadecimalDigits[] = "0123456789ABCDEF";
+	constexpr char LowerHexadecimalDigits[] = "0123456789abcdef";
+
+	constexpr uint64_t PowersOfTen[] =
+	{
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+		10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull,
+		10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+	};
+
+	auto CountLeadingZeros(uint64_t value) -> int
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return 63 - static_cast<int>(index);
+#else
+		return __builtin_clzll(value);
+#endif
+	}
+
+	auto DecimalLength(uint64_t value) -> int
+	{
+		// 1233 / 4096 approximates log10(2) so the bit length gives the digit count to within one
+
+		if (value == 0)
+			return 1;
+
+		auto bits = 64 - CountLeadingZeros(value);
+		auto estimate = (bits * 1233) >> 12;
+		return estimate - (value < PowersOfTen[estimate] ? 1 : 0) + 1;
+	}
+
+	auto HexadecimalLength(uint64_t value) -> int
+	{
+		if (value == 0)
+			return 1;
+
+		return (64 - CountLeadingZeros(value) + 3) / 4;
+	}
+
+	void FormatDecimal(char* output, int length, uint64_t value)
+	{
+		auto cursor = output + length;
+
+		while (value >= 100)
+		{
+			auto pair = static_cast<int>(value % 100) * 2;
+			value /= 100;
+
+			cursor -= 2;
+			cursor[0] = DecimalPairs[pair];
+			cursor[1] = DecimalPairs[pair + 1];
+		}
+
+		if (value >= 10)
+		{
+			auto pair = static_cast<int>(value) * 2;
+
+			cursor -= 2;
+			cursor[0] = DecimalPairs[pair];
+			cursor[1] = DecimalPairs[pair + 1];
+		}
+		else
+		{
+			*--cursor = static_cast<char>('0' + value);
+		}
+	}
+
+	void FormatHexadecimal(char* output, int length, uint64_t value, const char* digits)
+	{
+		for (auto cursor = output + length; cursor != output; value >>= 4)
+			*--cursor = digits[value & 0xF];
+	}
+
+	auto FormatSign(char* output, bool negative, const NumberFormat& format) -> int
+	{
+		if (negative)
+			output[0] = '-';
+		else if (format.Sign == '+' || format.Sign == ' ')
+			output[0] = format.Sign;
+		else
+			return 0;
+
+		return 1;
+	}
+
+	void WriteFill(StringWriter& writer, char fill, int count)
+	{
+		char run[32];
+		std::memset(run, fill, sizeof(run));
+
+		for (; count > 0; count -= 32)
+			writer.Write(StringView{ run, count < 32 ? count : 32 }, {});
+	}
+
+	void WritePadded(StringWriter& writer, const NumberFormat& format, const char* output, int signLength, int length)
+	{
+		auto padding = format.Width - length;
+
+		if (padding <= 0)
+		{
+			writer.Write(StringView{ output, length }, {});
+			return;
+		}
+
+		switch (format.Alignment)
+		{
+			case NumberFormat::AlignmentType::Left:
+			{
+				writer.Write(StringView{ output, length }, {});
+				WriteFill(writer, format.Fill, padding);
+				break;
+			}
+			case NumberFormat::AlignmentType::Right:
+			{
+				WriteFill(writer, format.Fill, padding);
+				writer.Write(StringView{ output, length }, {});
+				break;
+			}
+			case NumberFormat::AlignmentType::Center:
+			{
+				WriteFill(writer, format.Fill, padding / 2);
+				writer.Write(StringView{ output, length }, {});
+				WriteFill(writer, format.Fill, padding - padding / 2);
+				break;
+			}
+			case NumberFormat::AlignmentType::AfterSign:
+			{
+				writer.Write(StringView{ output, signLength }, {});
+				WriteFill(writer, format.Fill, padding);
+				writer.Write(StringView{ output + signLength, length - signLength }, {});
+				break;
+			}
+		}
+	}
+
+	void Grisu2Float(float value, char* buffer, int* length, int* K)
+	{
+		// the same steps as rapidjson's double Grisu2 but with the boundaries of a float so the digits round trip at float precision
+
+		using rapidjson::internal::DiyFp;
+
+		uint32_t bits;
+		std::memcpy(std::addressof(bits), std::addressof(value), sizeof(bits));
+
+		auto significand = bits & 0x7FFFFFu;
+		auto biased = static_cast<int>((bits >> 23) & 0xFF);
+		auto v = biased != 0 ? DiyFp(significand | 0x800000u, biased - 150) : DiyFp(significand, -149);
+
+		auto plus = DiyFp((v.f << 1) + 1, v.e - 1).Normalize();
+		auto minus = v.f == 0x800000u ? DiyFp((v.f << 2) - 1, v.e - 2) : DiyFp((v.f << 1) - 1, v.e - 1);
+
+		minus.f <<= minus.e - plus.e;
+		minus.e = plus.e;
+
+		auto cached = rapidjson::internal::GetCachedPower(plus.e, K);
+		auto w = v.Normalize() * cached;
+		auto upper = plus * cached;
+		auto lower = minus * cached;
+
+		lower.f++;
+		upper.f--;
+
+		rapidjson::internal::DigitGen(w, upper, upper.f - lower.f, buffer, length, K);
+	}
+
 	template<typename T>
-	void WriteInteger(StringWriter& writer, T number, const char* format)
+	auto FormatShortest(char* output, T number) -> char*
+	{
+		// the shortest digits that read back as the same value, always with a '.' so the result reads back as a rational
+
+		auto end = output;
+
+		if (number == 0)
+		{
+			*end++ = '0';
+			*end++ = '.';
+			*end++ = '0';
+		}
+		else
+		{
+			int length, K;
+
+			if constexpr (std::is_same<T, float>::value)
+				Grisu2Float(number, output, &length, &K);
+			else
+				rapidjson::internal::Grisu2(number, output, &length, &K);
+
+			end = rapidjson::internal::Prettify(output, length, K, 324);
+
+			if (std::find(output, end, '.') == end)
+			{
+				auto exponent = std::find(output, end, 'e');
+				std::memmove(exponent + 2, exponent, end - exponent);
+				exponent[0] = '.';
+				exponent[1] = '0';
+				end += 2;
+			}
+		}
+
+		return end;
+	}
+
+	auto FormatFixed(char* output, double number, int precision) -> char*
 	{
-		auto length = snprintf(nullptr, 0, format, number);
-		auto output = std::make_unique<char[]>(length + 1);
+		auto length = FormatScaledDecimal(number, precision, output);
+
+		if (precision == 0)
+			return output + length;
+
+		if (length <= precision)
+		{
+			auto zeros = precision + 1 - length;
+			std::memmove(output + zeros, output, length);
+			std::memset(output, '0', zeros);
+			length = precision + 1;
+		}
+
+		auto point = output + length - precision;
+		std::memmove(point + 1, point, precision);
+		*point = '.';
+
+		return output + length + 1;
+	}
+
+	auto FormatSignificantDigits(char* output, double number, int precision) -> int
+	{
+		// writes precision + 1 digits and returns the decimal exponent of the first - the estimate from log10 can be off
+		// by one either way and rounding can carry into an extra digit so the scale is adjusted until the count is right
+
+		if (number == 0)
+		{
+			std::memset(output, '0', precision + 1);
+			return 0;
+		}
+
+		auto exponent = static_cast<int>(std::floor(std::log10(number)));
+
+		while (true)
+		{
+			auto length = FormatScaledDecimal(number, precision - exponent, output);
+
+			if (length > precision + 1)
+				exponent++;
+			else if (length < precision + 1)
+				exponent--;
+			else
+				return exponent;
+		}
+	}
+
+	auto FormatExponent(char* output, char* digits, int precision, int exponent) -> char*
+	{
+		// d.ddde+XX with at least two exponent digits
+
+		auto end = output;
+
+		*end++ = digits[0];
+
+		if (precision > 0)
+		{
+			*end++ = '.';
+			std::memmove(end, digits + 1, precision);
+			end += precision;
+		}
+
+		*end++ = 'e';
+		*end++ = exponent < 0 ? '-' : '+';
+
+		auto magnitude = static_cast<uint64_t>(exponent < 0 ? -exponent : exponent);
+		auto length = magnitude < 10 ? 2 : DecimalLength(magnitude);
+		FormatDecimal(end, length, magnitude);
 
-		snprintf(output.get(), length + 1, format, number);
+		if (magnitude < 10)
+			end[0] = '0';
 
-		writer.Write(StringView{ output.get(), length }, {});
+		return end + length;
+	}
+
+	auto FormatScientific(char* output, double number, int precision) -> char*
+	{
+		char digits[NumberFormat::MaximumPrecision + 4];
+		auto exponent = FormatSignificantDigits(digits, number, precision);
+
+		return FormatExponent(output, digits, precision, exponent);
+	}
+
+	auto FormatGeneral(char* output, double number, int precision) -> char*
+	{
+		// the same choice between fixed and scientific as printf's %g including the removal of trailing zeros
+
+		if (precision == 0)
+			precision = 1;
+
+		char digits[NumberFormat::MaximumPrecision + 4];
+		auto exponent = FormatSignificantDigits(digits, number, precision - 1);
+
+		auto end = exponent >= -4 && exponent < precision
+			? FormatFixed(output, number, precision - 1 - exponent)
+			: FormatExponent(output, digits, precision - 1, exponent);
+
+		auto point = std::find(output, end, '.');
+
+		if (point != end)
+		{
+			auto fraction = std::find(point, end, 'e');
+			auto last = fraction;
+
+			while (last[-1] == '0')
+				last--;
+
+			if (last[-1] == '.')
+				last--;
+
+			std::memmove(last, fraction, end - fraction);
+			end -= fraction - last;
+		}
+
+		return end;
+	}
+
+	template<typename T>
+	void WriteRational(StringWriter& writer, T number, const NumberFormat& format)
+	{
+		// the longest output is the 309 digits of the largest double followed by the maximum precision
+
+		char output[320 + NumberFormat::MaximumPrecision];
+
+		auto negative = !std::isnan(number) && std::signbit(number);
+		auto sign = FormatSign(output, negative, format);
+		auto start = output + sign;
+		auto end = start;
+		auto magnitude = std::fabs(number);
+
+		auto precision = format.Precision < 0 ? 6 : format.Precision;
+		auto notation = format.Notation;
+
+		if (notation == NumberFormat::NotationType::Default && format.Precision >= 0)
+			notation = NumberFormat::NotationType::Fixed;
+
+		if (std::isnan(number))
+			end = std::copy_n("nan", 3, start);
+		else if (std::isinf(number))
+			end = std::copy_n("inf", 3, start);
+		else if (notation == NumberFormat::NotationType::Fixed)
+			end = FormatFixed(start, magnitude, precision);
+		else if (notation == NumberFormat::NotationType::Scientific)
+			end = FormatScientific(start, magnitude, precision);
+		else if (notation == NumberFormat::NotationType::General)
+			end = FormatGeneral(start, magnitude, precision);
+		else
+			end = FormatShortest(start, magnitude);
+
+		WritePadded(writer, format, output, sign, static_cast<int>(end - output));
 	}
 
 	template<typename T>
-	void WriteRational(StringWriter& writer, T number, const char* format)
+	void WriteInteger(StringWriter& writer, T number, const NumberFormat& format)
 	{
-		auto length = snprintf(nullptr, 0, format, number);
-		auto output = std::make_unique<char[]>(length + 1);
-		auto retreat = 0;
+		// the longest output is a sign followed by the 20 digits of a 64 bit value
+
+		using NotationType = NumberFormat::NotationType;
+
+		if (format.Notation == NotationType::Fixed || format.Notation == NotationType::Scientific || format.Notation == NotationType::General)
+		{
+			WriteRational(writer, static_cast<double>(number), format);
+			return;
+		}
+
+		char output[24];
 
-		snprintf(output.get(), length + 1, format, number);
+		auto negative = false;
+		auto magnitude = static_cast<uint64_t>(number);
 
-		while (output[length - retreat - 1] == '0' && output[length - retreat - 2] != '.')
-			retreat++;
+		if constexpr (std::is_signed<T>::value)
+		{
+			negative = number < 0;
+			if (negative)
+				magnitude = 0 - magnitude;
+		}
+
+		auto sign = FormatSign(output, negative, format);
+		auto hexadecimal = format.Notation == NotationType::Hexadecimal || format.Notation == NotationType::UpperHexadecimal;
+		auto length = hexadecimal ? HexadecimalLength(magnitude) : DecimalLength(magnitude);
+
+		if (format.Notation == NotationType::Hexadecimal)
+			FormatHexadecimal(output + sign, length, magnitude, LowerHexadecimalDigits);
+		else if (hexadecimal)
+			FormatHexadecimal(output + sign, length, magnitude, HexadecimalDigits);
+		else
+			FormatDecimal(output + sign, length, magnitude);
 
-		writer.Write(StringView{ output.get(), length - retreat }, {});
+		WritePadded(writer, format, output, sign, sign + length);
 	}
 }
 
@@ -46,10 +441,10 @@ void StringWriter::Write_(char character, StringView format)
 
 	if (format.Length() > 0 && format.Character(0) == 'n')
 		Write_(static_cast<int>(character), {});
-	if (format.Length() > 0 && format.Character(0) == '#')
+	else if (format.Length() > 0 && format.Character(0) == '#')
 		Write_(static_cast<int>(character), format);
 	else
-		_string.Append(character);
+		Append(&character, 1);
 }
 
 void StringWriter::Write_(wchar_t character, StringView format)
@@ -97,326 +492,429 @@ void StringWriter::Write_(bool boolean, StringView format)
 void StringWriter::Write_(signed char number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteInteger(*this, number, "%hhi");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(short number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteInteger(*this, number, "%hi");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(int number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteInteger(*this, number, "%i");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(long number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteInteger(*this, number, "%li");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(long long number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteInteger(*this, number, "%lli");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(unsigned char number, StringView format)
 {
 	// formats
-	// '#' -> write as a hex number
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	auto hex = format.Length() > 0 && format.Character(0) == '#';
-	WriteInteger(*this, number, hex ? "%hhX" : "%hhu");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(unsigned short number, StringView format)
 {
 	// formats
-	// '#' -> write as a hex number
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	auto hex = format.Length() > 0 && format.Character(0) == '#';
-	WriteInteger(*this, number, hex ? "%hX" : "%hu");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(unsigned int number, StringView format)
 {
 	// formats
-	// '#' -> write as a hex number
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	auto hex = format.Length() > 0 && format.Character(0) == '#';
-	WriteInteger(*this, number, hex ? "%X" : "%u");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(unsigned long number, StringView format)
 {
 	// formats
-	// '#' -> write as a hex number
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	auto hex = format.Length() > 0 && format.Character(0) == '#';
-	WriteInteger(*this, number, hex ? "%lX" : "%lu");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(unsigned long long number, StringView format)
 {
 	// formats
-	// '#' -> write as a hex number
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	auto hex = format.Length() > 0 && format.Character(0) == '#';
-	WriteInteger(*this, number, hex ? "%llX" : "%llu");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(float number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteRational(*this, static_cast<double>(number), "%f");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(double number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteRational(*this, number, "%f");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
 }
 
 void StringWriter::Write_(long double number, StringView format)
 {
 	// formats
-	// other -> write as number (default)
+	// see NumberFormat - empty writes as a decimal number (default)
 
-	WriteRational(*this, number, "%Lf");
+	WriteNumber(number, ParseNumberFormat(format.begin(), format.Length()));
+}
+
+void StringWriter::WriteNumber(signed char number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(short number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(int number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(long number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(long long number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(unsigned char number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(unsigned short number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(unsigned int number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(unsigned long number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(unsigned long long number, const NumberFormat& format)
+{
+	WriteInteger(*this, number, format);
+}
+
+void StringWriter::WriteNumber(float number, const NumberFormat& format)
+{
+	WriteRational(*this, number, format);
+}
+
+void StringWriter::WriteNumber(double number, const NumberFormat& format)
+{
+	WriteRational(*this, number, format);
+}
+
+void StringWriter::WriteNumber(long double number, const NumberFormat& format)
+{
+	WriteRational(*this, static_cast<double>(number), format);
 }
 
 namespace
 {
-	void WritePonValue(StringWriter& writer, const Blueprint& blueprint, int tabs, bool writeEqual, bool last)
+	void WriteQuoted(StringWriter& writer, StringView string)
 	{
-		if (writeEqual && !blueprint.IsArray() && !blueprint.IsObject())
-			writer.Write(tabs ? "= "_sv : "="_sv, {});
+		// runs without special characters are copied as is - the common escapes are written directly and any other
+		// control character is left to Escaped
 
-		if (blueprint.IsInvalid())
+		auto cursor = string.begin();
+		auto end = string.end();
+
+		writer.Write("\""_sv);
+
+		while (cursor != end)
 		{
-			writer.Write("invalid"_sv, {});
+			auto special = FindEscapeCharacter(cursor, end);
+
+			if (special != cursor)
+				writer.Write(StringView{ cursor, static_cast<int>(special - cursor) });
+
+			if (special == end)
+				break;
+
+			switch (*special)
+			{
+				case '"': writer.Write("\\\""_sv); break;
+				case '\\': writer.Write("\\\\"_sv); break;
+				case '\n': writer.Write("\\n"_sv); break;
+				case '\r': writer.Write("\\r"_sv); break;
+				case '\t': writer.Write("\\t"_sv); break;
+				default: writer.Write(Escaped(StringView{ special, 1 })); break;
+			}
+
+			cursor = special + 1;
 		}
-		else if (blueprint.IsNull())
+
+		writer.Write("\""_sv);
+	}
+
+	struct PonFrame
+	{
+		const Blueprint* Container;
+		int Next;
+		int Tabs;
+		bool Last;
+	};
+
+	void WritePonIndent(StringWriter& writer, int tabs)
+	{
+		static constexpr char Tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+		static constexpr int TabCount = sizeof(Tabs) - 1;
+
+		while (tabs > 0)
 		{
-			writer.Write("null"_sv, {});
+			auto count = tabs < TabCount ? tabs : TabCount;
+			writer.Write(StringView{ Tabs, count });
+			tabs -= count;
 		}
-		else if (blueprint.IsBoolean())
+	}
+
+	auto BeginPonValue(StringWriter& writer, List<PonFrame>& stack, const Blueprint& blueprint, int tabs, bool writeEqual, bool last) -> bool
+	{
+		// writes scalars completely and returns false - arrays and objects write their opening and are pushed on to the
+		// stack to have their children written
+
+		if (writeEqual && !blueprint.IsArray() && !blueprint.IsObject())
+			writer.Write(tabs ? "= "_sv : "="_sv);
+
+		if (blueprint.IsArray() || blueprint.IsObject())
 		{
-			writer.Write(blueprint.AsBoolean(), {});
+			auto empty = blueprint.IsArray() ? blueprint.AsArray()->Children.IsEmpty() : blueprint.AsObject()->Children.IsEmpty();
+
+			if (blueprint.IsArray())
+				writer.Write(tabs && !empty ? "[\n"_sv : "["_sv);
+			else
+				writer.Write(tabs && !empty ? "{\n"_sv : "{"_sv);
+
+			stack.Add({ &blueprint, 0, tabs, last });
+			return true;
 		}
+
+		if (blueprint.IsInvalid())
+			writer.Write("invalid"_sv);
+		else if (blueprint.IsNull())
+			writer.Write("null"_sv);
+		else if (blueprint.IsBoolean())
+			writer.Write(blueprint.AsBoolean(), {});
 		else if (blueprint.IsInteger())
-		{
 			writer.Write(blueprint.AsInteger(), {});
-		}
 		else if (blueprint.IsFloatingPoint())
-		{
 			writer.Write(blueprint.AsFloatingPoint(), {});
-		}
 		else if (blueprint.IsString())
-		{
-			auto escaped = Escaped(blueprint.AsStringView());
-			writer.Format("\"{}\"", escaped);
-		}
-		else if (blueprint.IsArray())
-		{
-			auto array = blueprint.AsArray();
-
-			writer.Write('[', {});
-			if (tabs && !array->Children.IsEmpty()) writer.Write('\n', {});
+			WriteQuoted(writer, blueprint.AsStringView());
 
-			auto count = 0;
-			for (auto& child : array->Children)
-			{
-				count++;
-				for (auto i = 0; i < tabs; i++)
-					writer.Write('\t', {});
+		if (!tabs && !last)
+			writer.Write(" "_sv);
 
-				WritePonValue(writer, child, tabs ? tabs + 1 : 0, false, count == array->Children.Count());
+		return false;
+	}
 
-				if (tabs)
-					writer.Write('\n', {});
-			}
+	void WritePonValue(StringWriter& writer, const Blueprint& blueprint, int tabs)
+	{
+		// tabs is 0 for compact output - children of a pretty printed container are indented one level further than it
 
-			if (tabs && !array->Children.IsEmpty())
-			{
-				for (auto i = 0; i < (tabs - 1); i++)
-					writer.Write('\t', {});
-			}
+		List<PonFrame> stack;
+		BeginPonValue(writer, stack, blueprint, tabs, false, true);
 
-			writer.Write(']', {});
-		}
-		else if (blueprint.IsObject())
+		while (!stack.IsEmpty())
 		{
-			auto object = blueprint.AsObject();
-
-			writer.Write('{', {});
-			if (tabs && !object->Children.IsEmpty()) writer.Write('\n', {});
+			auto frame = stack.Last();
+			auto isArray = frame.Container->IsArray();
+			auto count = isArray ? frame.Container->AsArray()->Children.Count() : frame.Container->AsObject()->Children.Count();
 
-			auto count = 0;
-			for (auto i = 0; i < object->Children.Count(); i++)
+			if (frame.Next < count)
 			{
-				auto& key = object->Children.GetKey(i);
-				auto& item = object->Children.ItemAtIndex(i);
+				auto index = stack.Last().Next++;
 
-				count++;
-				for (auto i = 0; i < tabs; i++)
-					writer.Write('\t', {});
+				WritePonIndent(writer, frame.Tabs);
 
-				if (!key.IsEmpty())
+				if (isArray)
 				{
-					writer.Write(key, {});
-					if (tabs) writer.Write(' ', {});
+					auto& child = frame.Container->AsArray()->Children.Item(index);
+
+					if (!BeginPonValue(writer, stack, child, frame.Tabs ? frame.Tabs + 1 : 0, false, index == count - 1) && frame.Tabs)
+						writer.Write("\n"_sv);
 				}
+				else
+				{
+					auto& key = frame.Container->AsObject()->Children.GetKey(index);
+					auto& child = frame.Container->AsObject()->Children.ItemAtIndex(index);
 
-				WritePonValue(writer, item, tabs ? tabs + 1 : 0, true, count == object->Children.Count());
+					if (!key.IsEmpty())
+					{
+						writer.Write(key);
+						if (frame.Tabs) writer.Write(" "_sv);
+					}
 
-				if (tabs)
-					writer.Write('\n', {});
+					if (!BeginPonValue(writer, stack, child, frame.Tabs ? frame.Tabs + 1 : 0, true, index == count - 1) && frame.Tabs)
+						writer.Write("\n"_sv);
+				}
 			}
-
-			if (tabs && !object->Children.IsEmpty())
+			else
 			{
-				for (auto i = 0; i < (tabs - 1); i++)
-					writer.Write('\t', {});
-			}
+				stack.RemoveLast();
 
-			writer.Write('}', {});
-		}
+				if (frame.Tabs && count > 0)
+					WritePonIndent(writer, frame.Tabs - 1);
 
-		if (!tabs && !last)
-			writer.Write(' ', {});
+				writer.Write(isArray ? "]"_sv : "}"_sv);
+
+				if (!frame.Tabs && !frame.Last)
+					writer.Write(" "_sv);
+
+				if (!stack.IsEmpty() && stack.Last().Tabs)
+					writer.Write("\n"_sv);
+			}
+		}
 	}
 
-	struct WriteStream
+	class WriteStream
 	{
+	public:
 		using Ch = char;
 
+		static constexpr int ChunkSize = 256;
+
+		WriteStream(StringWriter& writer) : _writer(writer) {}
+		~WriteStream() { Flush(); }
+
 		auto PutBegin() -> Ch* { return nullptr; }
 		auto PutEnd(Ch* begin) -> size_t { return 0; }
-		void Put(Ch c) { Writer.Write(c, {}); }
-		void Flush() {}
 
-		StringWriter& Writer;
-	};
+		void Put(Ch c)
+		{
+			if (_count == ChunkSize)
+				Flush();
 
-	void WriteJsonArray(const Blueprint& blueprint, rapidjson::Value& value, rapidjson::MemoryPoolAllocator<>& allocator);
+			if (_chunk == nullptr)
+				_chunk = _writer.Reserve(ChunkSize);
 
-	void WriteJsonObject(const Blueprint& blueprint, rapidjson::Value& value, rapidjson::MemoryPoolAllocator<>& allocator)
-	{
-		auto object = blueprint.AsObject();
+			_chunk[_count++] = c;
+		}
 
-		for (auto i = 0; i < object->Children.Count(); i++)
+		void Flush()
 		{
-			auto& key = object->Children.GetKey(i);
-			auto& child = object->Children.ItemAtIndex(i);
-			auto name = rapidjson::GenericStringRef<char>(key.begin());
-
-			if (child.IsInvalid())
-			{
-			}
-			else if (child.IsNull())
-			{
-				value.AddMember(name, rapidjson::Value(rapidjson::Type::kNullType), allocator);
-			}
-			else if (child.IsBoolean())
-			{
-				value.AddMember(name, child.AsBoolean(), allocator);
-			}
-			else if (child.IsInteger())
-			{
-				value.AddMember(name, static_cast<int64_t>(child.AsInteger()), allocator);
-			}
-			else if (child.IsFloatingPoint())
-			{
-				value.AddMember(name, child.AsFloatingPoint(), allocator);
-			}
-			else if (child.IsString())
-			{
-				auto string = rapidjson::GenericStringRef<char>(child.AsStringView().begin());
-				value.AddMember(name, string, allocator);
-			}
-			else if (child.IsArray())
-			{
-				auto member = rapidjson::Value(rapidjson::Type::kArrayType);
-
-				WriteJsonArray(child, member, allocator);
-				value.AddMember(name, std::move(member), allocator);
-			}
-			else if (child.IsObject())
-			{
-				auto member = rapidjson::Value(rapidjson::Type::kObjectType);
+			if (_chunk != nullptr)
+				_writer.Commit(_count);
 
-				WriteJsonObject(child, member, allocator);
-				value.AddMember(name, std::move(member), allocator);
-			}
+			_chunk = nullptr;
+			_count = 0;
 		}
-	}
 
-	void WriteJsonArray(const Blueprint& blueprint, rapidjson::Value& value, rapidjson::MemoryPoolAllocator<>& allocator)
+	private:
+		StringWriter& _writer;
+		Ch* _chunk = nullptr;
+		int _count = 0;
+	};
+
+	template<typename OutputType>
+	void WriteJsonEvents(const Blueprint& blueprint, OutputType& output)
 	{
-		auto array = blueprint.AsArray();
+		// walks the blueprint straight into the rapidjson writer rather than building a document first - invalid children
+		// are skipped
 
-		for (auto& child : array->Children)
+		if (blueprint.IsNull())
 		{
-			if (child.IsInvalid())
-			{
-			}
-			else if (child.IsNull())
-			{
-				value.PushBack(rapidjson::Value(rapidjson::Type::kNullType), allocator);
-			}
-			else if (child.IsBoolean())
-			{
-				value.PushBack(child.AsBoolean(), allocator);
-			}
-			else if (child.IsInteger())
-			{
-				value.PushBack(static_cast<int64_t>(child.AsInteger()), allocator);
-			}
-			else if (child.IsFloatingPoint())
-			{
-				value.PushBack(child.AsFloatingPoint(), allocator);
-			}
-			else if (child.IsString())
-			{
-				auto string = rapidjson::GenericStringRef<char>(child.AsStringView().begin());
-				value.PushBack(string, allocator);
-			}
-			else if (child.IsArray())
+			output.Null();
+		}
+		else if (blueprint.IsBoolean())
+		{
+			output.Bool(blueprint.AsBoolean());
+		}
+		else if (blueprint.IsInteger())
+		{
+			output.Int64(static_cast<int64_t>(blueprint.AsInteger()));
+		}
+		else if (blueprint.IsFloatingPoint())
+		{
+			output.Double(blueprint.AsFloatingPoint());
+		}
+		else if (blueprint.IsString())
+		{
+			auto string = blueprint.AsStringView();
+			output.String(string.begin(), static_cast<rapidjson::SizeType>(string.Length()));
+		}
+		else if (blueprint.IsArray())
+		{
+			auto array = blueprint.AsArray();
+
+			output.StartArray();
+
+			for (auto& child : array->Children)
 			{
-				auto member = rapidjson::Value(rapidjson::Type::kArrayType);
-				WriteJsonArray(child, member, allocator);
-				value.PushBack(std::move(member), allocator);
+				if (!child.IsInvalid())
+					WriteJsonEvents(child, output);
 			}
-			else if (child.IsObject())
+
+			output.EndArray();
+		}
+		else if (blueprint.IsObject())
+		{
+			auto object = blueprint.AsObject();
+
+			output.StartObject();
+
+			for (auto i = 0; i < object->Children.Count(); i++)
 			{
-				auto member = rapidjson::Value(rapidjson::Type::kObjectType);
-				WriteJsonObject(child, member, allocator);
-				value.PushBack(std::move(member), allocator);
+				auto& key = object->Children.GetKey(i);
+				auto& child = object->Children.ItemAtIndex(i);
+
+				if (!child.IsInvalid())
+				{
+					output.Key(key.begin(), static_cast<rapidjson::SizeType>(key.Length()));
+					WriteJsonEvents(child, output);
+				}
 			}
+
+			output.EndObject();
 		}
 	}
 
@@ -448,31 +946,18 @@ namespace
 		}
 		else
 		{
-			rapidjson::Document document;
-
-			if (blueprint.IsObject())
-			{
-				auto& value = document.SetObject();
-				WriteJsonObject(blueprint, value, document.GetAllocator());
-			}
-			else if (blueprint.IsArray())
-			{
-				auto& value = document.SetArray();
-				WriteJsonArray(blueprint, value, document.GetAllocator());
-			}
-
-			auto stream = WriteStream{ writer };
+			WriteStream stream(writer);
 
 			if (prettyPrint)
 			{
 				rapidjson::PrettyWriter<WriteStream> output(stream);
 				output.SetIndent('\t', 1);
-				document.Accept(output);
+				WriteJsonEvents(blueprint, output);
 			}
 			else
 			{
 				rapidjson::Writer<WriteStream> output(stream);
-				document.Accept(output);
+				WriteJsonEvents(blueprint, output);
 			}
 		}
 	}
@@ -490,24 +975,300 @@ void StringWriter::Write_(const Blueprint& blueprint, StringView format)
 		WriteJsonValue(*this, blueprint, false);
 	else if (Equals(format, "json"))
 		WriteJsonValue(*this, blueprint, true);
-	if (Equals(format, "PON"))
-		WritePonValue(*this, blueprint, 0, false, true);
+	else if (Equals(format, "PON"))
+		WritePonValue(*this, blueprint, 0);
 	else
-		WritePonValue(*this, blueprint, 1, false, true);
+		WritePonValue(*this, blueprint, 1);
 }
 
 void StringWriter::WriteString(StringView string, StringView format)
 {
-	_string.Append(string);
+	Append(string.begin(), string.Length());
 }
 
 void StringWriter::WriteText(TextView text, StringView format)
 {
-	_string.Append(text.GetString());
+	auto string = text.GetString();
+	Append(string.begin(), string.Length());
+}
+
+StringWriter::StringWriter(StringWriter&& other)
+{
+	MoveFrom(other);
+}
+
+auto StringWriter::operator=(StringWriter&& other) -> StringWriter&
+{
+	if (this != &other)
+	{
+		Flush();
+		MoveFrom(other);
+	}
+
+	return *this;
+}
+
+void StringWriter::MoveFrom(StringWriter& other)
+{
+	// the output, destination and flush function all move over and other is left as an empty heap writer so its
+	// destructor has nothing to flush
+
+	_string = std::move(other._string);
+	_buffer = std::exchange(other._buffer, nullptr);
+	_capacity = std::exchange(other._capacity, 0);
+	_size = std::exchange(other._size, 0);
+	_external = std::exchange(other._external, false);
+	_overflowToHeap = std::exchange(other._overflowToHeap, false);
+	_overflowed = std::exchange(other._overflowed, false);
+	_chunks = std::move(other._chunks);
+	_spareChunks = std::move(other._spareChunks);
+	_chunkSize = std::exchange(other._chunkSize, 0);
+	_flush = std::exchange(other._flush, nullptr);
+	_storage = std::move(other._storage);
+	_flushed = std::exchange(other._flushed, 0);
+	_failed = std::exchange(other._failed, false);
+	_reserved = std::move(other._reserved);
+	_reservedInPlace = std::exchange(other._reservedInPlace, false);
+
+	other._string.Clear();
+	other._chunks.Clear();
+	other._spareChunks.Clear();
+	other._reserved.Clear();
+}
+
+void StringWriter::Reset()
+{
+	// anything still buffered for a flush function is flushed first and chunks are kept for AddChunk to hand out
+	// again, so a writer that is reset between uses stops allocating once it has seen its largest output
+
+	Flush();
+
+	for (auto& chunk : _chunks)
+	{
+		chunk.Size = 0;
+		_spareChunks.Add(std::move(chunk));
+	}
+
+	_string.Clear();
+	_chunks.Clear();
+	_size = 0;
+	_flushed = 0;
+	_overflowed = false;
+	_failed = false;
+	_reservedInPlace = false;
+}
+
+auto StringWriter::Reserve(int count) -> char*
+{
+	// the region is written in place when the external buffer has room for it or when it fits in a chunk, and is
+	// otherwise staged in _reserved until it is committed - a chunk without enough room is left partly empty rather
+	// than splitting the region
+
+	if (_flush && _capacity - _size < count && count <= _capacity)
+		Flush();
+
+	if (_chunkSize > 0 && count <= _chunkSize)
+	{
+		if (_chunks.IsEmpty() || _chunks.Last().Capacity - _chunks.Last().Size < count)
+			AddChunk(_chunkSize);
+
+		_reservedInPlace = true;
+		return _chunks.Last().Characters.get() + _chunks.Last().Size;
+	}
+
+	_reservedInPlace = _external && !_overflowed && _capacity - _size >= count;
+
+	if (_reservedInPlace)
+		return _buffer + _size;
+
+	_reserved.EnsureCount(count, {});
+	return _reserved.begin();
+}
+
+void StringWriter::Commit(int count)
+{
+	if (_reservedInPlace)
+	{
+		if (_chunkSize > 0)
+			_chunks.Last().Size += count;
+
+		_size += count;
+	}
+	else
+	{
+		Append(_reserved.begin(), count);
+	}
+
+	_reservedInPlace = false;
+}
+
+void StringWriter::Append(const char* characters, int count)
+{
+	// writes to an external buffer keep counting past its capacity so the required size can be reported - a buffer
+	// that overflows to the heap moves its contents to _string the first time it runs out of room
+
+	if (_chunkSize > 0)
+	{
+		_size += count;
+
+		while (count > 0)
+		{
+			if (_chunks.IsEmpty() || _chunks.Last().Size == _chunks.Last().Capacity)
+				AddChunk(_chunkSize);
+
+			auto& chunk = _chunks.Last();
+			auto copied = std::min(count, chunk.Capacity - chunk.Size);
+
+			std::memcpy(chunk.Characters.get() + chunk.Size, characters, copied);
+			chunk.Size += copied;
+			characters += copied;
+			count -= copied;
+		}
+
+		return;
+	}
+
+	if (!_external || _overflowed)
+	{
+		_string.Append(StringView{ characters, count });
+		return;
+	}
+
+	if (_flush && _capacity - _size < count)
+	{
+		Flush();
+
+		if (count > _capacity)
+		{
+			_failed = _failed || !_flush(StringView{ characters, count });
+			_flushed += count;
+			return;
+		}
+	}
+
+	auto available = _capacity - _size;
+
+	if (count <= available)
+	{
+		std::memcpy(_buffer + _size, characters, count);
+	}
+	else if (_overflowToHeap)
+	{
+		_string.Append(StringView{ _buffer, _size });
+		_string.Append(StringView{ characters, count });
+		_overflowed = true;
+	}
+	else if (available > 0)
+	{
+		std::memcpy(_buffer + _size, characters, available);
+	}
+
+	_size += count;
+}
+
+void StringWriter::Flush()
+{
+	// once the destination fails the remaining output is counted but discarded
+
+	if (!_flush || _size == 0)
+		return;
+
+	_failed = _failed || !_flush(StringView{ _buffer, _size });
+	_flushed += _size;
+	_size = 0;
+}
+
+void StringWriter::AddChunk(int capacity) const
+{
+	// chunks are never resized so nothing that was written is copied again until the output is flattened
+
+	auto& chunk = _chunks.Increment();
+
+	if (!_spareChunks.IsEmpty() && _spareChunks.Last().Capacity >= capacity)
+	{
+		chunk = std::move(_spareChunks.Last());
+		_spareChunks.RemoveLast();
+		return;
+	}
+
+	chunk.Characters.reset(new char[capacity]);
+	chunk.Size = 0;
+	chunk.Capacity = capacity;
+}
+
+void StringWriter::Flatten() const
+{
+	// merges the chunks into one that is large enough for everything written so far - later writes continue in any
+	// space left at its end
+
+	if (_chunks.Count() <= 1)
+		return;
+
+	auto chunks = std::move(_chunks);
+	_chunks.Clear();
+
+	AddChunk(std::max(_size, _chunkSize));
+
+	auto& merged = _chunks.Last();
+
+	for (auto& chunk : chunks)
+	{
+		std::memcpy(merged.Characters.get() + merged.Size, chunk.Characters.get(), chunk.Size);
+		merged.Size += chunk.Size;
+	}
 }
 
 void StringWriter::WriteBuffer(BufferView buffer, StringView format)
 {
-	auto base64 = ToBase64(buffer);
-	WriteString(base64, {});
-}
\ No newline at end of file
+	// encodes in chunks so large buffers do not need an equally large staging area when reserving
+
+	constexpr auto chunkSize = 3 * 1024;
+
+	for (auto index = 0; index < buffer.Size(); index += chunkSize)
+	{
+		auto size = std::min(chunkSize, buffer.Size() - index);
+		auto encodedSize = Base64EncodedSize(size);
+
+		EncodeBase64(buffer.begin() + index, size, Reserve(encodedSize));
+		Commit(encodedSize);
+	}
+}
+
+auto Pargon::FlushToFile(std::FILE* file) -> StringWriter::FlushFunction
+{
+	return [file](StringView characters)
+	{
+		return std::fwrite(characters.begin(), 1, characters.Length(), file) == static_cast<std::size_t>(characters.Length());
+	};
+}
+
+auto Pargon::FlushToDescriptor(int descriptor) -> StringWriter::FlushFunction
+{
+	// write can return after writing only part of the characters so it is repeated until all of them are written
+
+	return [descriptor](StringView characters)
+	{
+		auto cursor = characters.begin();
+		auto remaining = characters.Length();
+
+		while (remaining > 0)
+		{
+#if defined(_MSC_VER)
+			auto written = _write(descriptor, cursor, static_cast<unsigned int>(remaining));
+#else
+			auto written = write(descriptor, cursor, static_cast<std::size_t>(remaining));
+#endif
+
+			if (written < 0 && errno == EINTR)
+				continue;
+
+			if (written < 0)
+				return false;
+
+			cursor += written;
+			remaining -= static_cast<int>(written);
+		}
+
+		return true;
+	};
+}
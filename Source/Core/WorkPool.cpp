@@ -0,0 +1,166 @@
+#include "Pargon/Serialization/WorkPool.h"
+
+#include <algorithm>
+
+using namespace Pargon;
+
+namespace
+{
+	auto PackRange(uint32_t begin, uint32_t end) -> uint64_t
+	{
+		return (static_cast<uint64_t>(begin) << 32) | end;
+	}
+
+	auto RangeBegin(uint64_t range) -> uint32_t
+	{
+		return static_cast<uint32_t>(range >> 32);
+	}
+
+	auto RangeEnd(uint64_t range) -> uint32_t
+	{
+		return static_cast<uint32_t>(range);
+	}
+}
+
+WorkPool::WorkPool(int workerCount) :
+	_workerCount(std::max(workerCount, 1)),
+	_remaining(0)
+{
+	// the thread calling Run is always worker 0 so only the additional workers need threads
+
+	_queues = std::make_unique<Queue[]>(_workerCount);
+	_threads = std::make_unique<std::thread[]>(_workerCount - 1);
+
+	for (auto i = 0; i < _workerCount; i++)
+		_queues[i].Range.store(0);
+
+	for (auto i = 1; i < _workerCount; i++)
+		_threads[i - 1] = std::thread(&WorkPool::Work, this, i);
+}
+
+WorkPool::~WorkPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+
+	_start.notify_all();
+
+	for (auto i = 1; i < _workerCount; i++)
+		_threads[i - 1].join();
+}
+
+void WorkPool::Run(int taskCount, const Task& task)
+{
+	if (taskCount <= 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		// each worker starts with a contiguous share of the tasks and steals from the back of the others' shares once its own is empty
+
+		for (auto i = 0; i < _workerCount; i++)
+		{
+			auto begin = static_cast<uint32_t>(static_cast<long long>(taskCount) * i / _workerCount);
+			auto end = static_cast<uint32_t>(static_cast<long long>(taskCount) * (i + 1) / _workerCount);
+			_queues[i].Range.store(PackRange(begin, end));
+		}
+
+		_task = std::addressof(task);
+		_remaining.store(taskCount);
+		_generation++;
+	}
+
+	_start.notify_all();
+	Drain(0);
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_finish.wait(lock, [this] { return _remaining.load() == 0 && _active == 0; });
+	_task = nullptr;
+}
+
+void WorkPool::Work(int worker)
+{
+	auto generation = 0;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (true)
+	{
+		_start.wait(lock, [&] { return _stopping || _generation != generation; });
+
+		if (_stopping)
+			return;
+
+		generation = _generation;
+		_active++;
+
+		lock.unlock();
+		Drain(worker);
+		lock.lock();
+
+		_active--;
+		_finish.notify_all();
+	}
+}
+
+void WorkPool::Drain(int worker)
+{
+	auto task = 0;
+
+	while (true)
+	{
+		while (Pop(worker, task))
+		{
+			(*_task)(task, worker);
+			_remaining.fetch_sub(1);
+		}
+
+		auto stolen = false;
+
+		for (auto offset = 1; offset < _workerCount && !stolen; offset++)
+			stolen = Steal((worker + offset) % _workerCount, task);
+
+		if (!stolen)
+			return;
+
+		(*_task)(task, worker);
+		_remaining.fetch_sub(1);
+	}
+}
+
+auto WorkPool::Pop(int worker, int& task) -> bool
+{
+	auto& range = _queues[worker].Range;
+	auto current = range.load();
+
+	while (RangeBegin(current) < RangeEnd(current))
+	{
+		if (range.compare_exchange_weak(current, PackRange(RangeBegin(current) + 1, RangeEnd(current))))
+		{
+			task = static_cast<int>(RangeBegin(current));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+auto WorkPool::Steal(int victim, int& task) -> bool
+{
+	auto& range = _queues[victim].Range;
+	auto current = range.load();
+
+	while (RangeBegin(current) < RangeEnd(current))
+	{
+		if (range.compare_exchange_weak(current, PackRange(RangeBegin(current), RangeEnd(current) - 1)))
+		{
+			task = static_cast<int>(RangeEnd(current) - 1);
+			return true;
+		}
+	}
+
+	return false;
+}
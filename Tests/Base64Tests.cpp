@@ -0,0 +1,132 @@
+#include "Pargon/Containers/Buffer.h"
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Core/Base64.h"
+#include "Check.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	const char Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	auto Encode(const std::vector<uint8_t>& data) -> std::string
+	{
+		// one group at a time so the vector paths have something plain to agree with
+
+		std::string text;
+
+		for (size_t index = 0; index < data.size(); index += 3)
+		{
+			auto remaining = data.size() - index;
+			auto group = static_cast<uint32_t>(data[index]) << 16;
+
+			if (remaining > 1) group |= static_cast<uint32_t>(data[index + 1]) << 8;
+			if (remaining > 2) group |= static_cast<uint32_t>(data[index + 2]);
+
+			text += Alphabet[group >> 18];
+			text += Alphabet[(group >> 12) & 63];
+			text += remaining > 1 ? Alphabet[(group >> 6) & 63] : '=';
+			text += remaining > 2 ? Alphabet[group & 63] : '=';
+		}
+
+		return text;
+	}
+
+	auto Read(const std::string& text, Buffer& buffer, int& index) -> bool
+	{
+		StringReader reader{ StringView{ text.data(), static_cast<int>(text.size()) } };
+		reader.Read(buffer, {});
+		index = reader.Index();
+
+		return !reader.HasFailed();
+	}
+
+	auto Same(const Buffer& buffer, const std::vector<uint8_t>& data) -> bool
+	{
+		return buffer.Size() == static_cast<int>(data.size()) && (data.empty() || std::memcmp(buffer.begin(), data.data(), data.size()) == 0);
+	}
+
+	void TestRoundTrip()
+	{
+		// every length around the 12 and 16 byte blocks the vector paths work in
+
+		std::mt19937 random(3);
+		std::vector<int> lengths;
+
+		for (auto length = 0; length <= 100; length++)
+			lengths.push_back(length);
+
+		for (auto length : { 1023, 1024, 1025, 10000 })
+			lengths.push_back(length);
+
+		for (auto length : lengths)
+		{
+			std::vector<uint8_t> data(length);
+			for (auto& byte : data)
+				byte = static_cast<uint8_t>(random());
+
+			auto expected = Encode(data);
+
+			std::string encoded(Base64EncodedSize(length), '\0');
+			EncodeBase64(data.data(), length, &encoded[0]);
+			PARGON_CHECK(encoded == expected);
+
+			Buffer buffer;
+			auto index = 0;
+			PARGON_CHECK(Read(expected, buffer, index) && index == static_cast<int>(expected.size()) && Same(buffer, data));
+
+			// unpadded text decodes the same
+
+			auto unpadded = expected.substr(0, expected.find('='));
+			PARGON_CHECK(Read(unpadded, buffer, index) && index == static_cast<int>(unpadded.size()) && Same(buffer, data));
+		}
+	}
+
+	void TestStray()
+	{
+		// a character outside the alphabet ends the run and is left for whatever reads next
+
+		Buffer buffer;
+		auto index = 0;
+
+		PARGON_CHECK(Read("aGVsbG8=,next", buffer, index) && index == 8 && Same(buffer, { 'h', 'e', 'l', 'l', 'o' }));
+		PARGON_CHECK(Read("aGVsbG8 next", buffer, index) && index == 7 && Same(buffer, { 'h', 'e', 'l', 'l', 'o' }));
+		PARGON_CHECK(Read("aGVsbG8hIHRoZXJlIGFnYWlu!x", buffer, index) && index == 24);
+		PARGON_CHECK(Read(",", buffer, index) && index == 0 && buffer.Size() == 0);
+
+		std::string text(40, 'A');
+		text[38] = '\n';
+		PARGON_CHECK(Read(text, buffer, index) && index == 38);
+	}
+
+	void TestLoneDigit()
+	{
+		// a final group of one digit carries only six bits and is an error rather than being dropped
+
+		Buffer buffer;
+		auto index = 0;
+
+		PARGON_CHECK(!Read("A", buffer, index));
+		PARGON_CHECK(!Read("aGVsb", buffer, index));
+		PARGON_CHECK(!Read("aGVsb=", buffer, index));
+		PARGON_CHECK(!Read("aGVsb,next", buffer, index));
+		PARGON_CHECK(!Read(std::string(33, 'A'), buffer, index));
+		PARGON_CHECK(Read(std::string(34, 'A'), buffer, index) && buffer.Size() == 25);
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestStray();
+	TestLoneDigit();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,173 @@
+#include "Pargon/Containers/List.h"
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/BatchReader.h"
+#include "Pargon/Serialization/BatchWriter.h"
+#include "Check.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	struct Flags
+	{
+		bool Visible;
+		bool Active;
+		bool Selected;
+
+		void ToBuffer(BufferWriter& writer) const
+		{
+			writer.WriteBit(Visible);
+			writer.WriteBit(Active);
+			writer.WriteBit(Selected);
+		}
+
+		void FromBuffer(BufferReader& reader)
+		{
+			Visible = reader.ReadBit();
+			Active = reader.ReadBit();
+			Selected = reader.ReadBit();
+		}
+	};
+
+	void TestRoundTrip()
+	{
+		List<int> numbers;
+		for (auto i = 0; i < 10; i++)
+			numbers.Add(i * 3);
+
+		BatchWriter batch;
+		PARGON_CHECK(batch.AddRange(numbers));
+		PARGON_CHECK(batch.Add(StringView("hello")));
+
+		auto view = batch.Finish();
+		BatchReader reader(view);
+		BatchReader direct(view, batch.GetIndex());
+
+		PARGON_CHECK(reader.IsValid() && reader.Count() == 11);
+		PARGON_CHECK(direct.IsValid() && direct.Count() == 11);
+
+		for (auto i = 0; i < 10; i++)
+		{
+			int value = -1;
+			PARGON_CHECK(reader.Read(i, value) && value == i * 3);
+			PARGON_CHECK(direct.Read(i, value) && value == i * 3);
+		}
+
+		StringView text;
+		PARGON_CHECK(reader.Read(10, text) && Equals(text, "hello"));
+		PARGON_CHECK(reader.GetView(11).Size() == 0);
+	}
+
+	void TestBitPacked()
+	{
+		// each bit packed item gets its own byte so it can be read back on its own
+
+		BatchWriter batch;
+		batch.Add(Flags{ true, false, true });
+		batch.Add(Flags{ false, true, true });
+		batch.Add(12345);
+
+		auto index = batch.GetIndex();
+		PARGON_CHECK(index.Item(0).Offset == 0 && index.Item(0).Length == 1);
+		PARGON_CHECK(index.Item(1).Offset == 1 && index.Item(1).Length == 1);
+		PARGON_CHECK(index.Item(2).Offset == 2);
+
+		BatchReader reader(batch.Finish());
+		Flags first = {}, second = {};
+		int number = 0;
+
+		PARGON_CHECK(reader.Read(0, first) && first.Visible && !first.Active && first.Selected);
+		PARGON_CHECK(reader.Read(1, second) && !second.Visible && second.Active && second.Selected);
+		PARGON_CHECK(reader.Read(2, number) && number == 12345);
+	}
+
+	void TestFinished()
+	{
+		// adding after Finish would write items past the trailer
+
+		BatchWriter batch;
+		batch.Add(1);
+		batch.Add(2);
+
+		auto size = batch.Finish().Size();
+
+		PARGON_CHECK(!batch.Add(3));
+		PARGON_CHECK(!batch.AddRange(List<int>{}));
+		PARGON_CHECK(batch.Finish().Size() == size);
+		PARGON_CHECK(batch.Count() == 2);
+
+		BatchReader reader(batch.GetBuffer());
+		PARGON_CHECK(reader.IsValid() && reader.Count() == 2);
+
+		batch.Reset();
+		PARGON_CHECK(batch.Add(4));
+
+		BatchReader reset(batch.Finish());
+		int value = 0;
+		PARGON_CHECK(reset.Count() == 1 && reset.Read(0, value) && value == 4);
+	}
+
+	void TestTrailerLayout()
+	{
+		// the trailer is little endian whatever the machine so the bytes are the same everywhere
+
+		BatchWriter batch;
+		batch.Add(static_cast<uint8_t>(7));
+		batch.Add(static_cast<uint8_t>(9));
+
+		const uint8_t expected[] = { 7, 9, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0 };
+
+		auto view = batch.Finish();
+		PARGON_CHECK(view.Size() == sizeof(expected) && std::memcmp(view.begin(), expected, sizeof(expected)) == 0);
+
+		BatchReader reader({ expected, static_cast<int>(sizeof(expected)) });
+		uint8_t first = 0, second = 0;
+		PARGON_CHECK(reader.IsValid() && reader.Count() == 2);
+		PARGON_CHECK(reader.Read(0, first) && first == 7 && reader.Read(1, second) && second == 9);
+	}
+
+	void TestTruncatedAndCorrupt()
+	{
+		// any prefix of a batch either fails to open or only hands out views inside the prefix
+
+		BatchWriter batch;
+		for (auto i = 0; i < 20; i++)
+			batch.Add(i);
+
+		auto view = batch.Finish();
+		std::vector<uint8_t> bytes(view.begin(), view.end());
+
+		for (auto length = 0; length < static_cast<int>(bytes.size()); length++)
+		{
+			BatchReader reader({ bytes.data(), length });
+
+			for (auto i = 0; reader.IsValid() && i < reader.Count(); i++)
+			{
+				auto item = reader.GetView(i);
+				PARGON_CHECK(item.Size() == 0 || (item.begin() >= bytes.data() && item.end() <= bytes.data() + length));
+			}
+		}
+
+		auto count = 0x7FFFFFFF;
+		std::memcpy(bytes.data() + bytes.size() - sizeof(count), &count, sizeof(count));
+		PARGON_CHECK(!BatchReader({ bytes.data(), static_cast<int>(bytes.size()) }).IsValid());
+
+		count = -1;
+		std::memcpy(bytes.data() + bytes.size() - sizeof(count), &count, sizeof(count));
+		PARGON_CHECK(!BatchReader({ bytes.data(), static_cast<int>(bytes.size()) }).IsValid());
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestBitPacked();
+	TestFinished();
+	TestTrailerLayout();
+	TestTruncatedAndCorrupt();
+
+	return PargonTests::Failures;
+}
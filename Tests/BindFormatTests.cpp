@@ -0,0 +1,76 @@
+#include "Pargon/Containers/List.h"
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/Serialization.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+using namespace Pargon;
+
+namespace
+{
+	auto Names(StringView first, StringView second) -> List<StringView>
+	{
+		List<StringView> names;
+		names.Add(first);
+		names.Add(second);
+		return names;
+	}
+
+	void TestBound()
+	{
+		// named tokens take the position of their name so the arguments follow the order of names, not of the format
+
+		auto format = ParseFormatString("{count} items in {place}");
+
+		PARGON_CHECK(BindFormat(format, Names("place", "count")));
+		PARGON_CHECK(format.Tokens.Item(0).ParameterIndex == 1);
+		PARGON_CHECK(format.Tokens.Item(2).ParameterIndex == 0);
+
+		StringWriter writer;
+		writer.Format(format, "the box", 12);
+		PARGON_CHECK(Equals(writer.GetString(), "12 items in the box"));
+	}
+
+	void TestMissingName()
+	{
+		// every name that can be found is still bound
+
+		auto format = ParseFormatString("{known} and {unknown}");
+
+		PARGON_CHECK(!BindFormat(format, Names("known", "other")));
+		PARGON_CHECK(format.Tokens.Item(0).ParameterIndex == 0);
+		PARGON_CHECK(format.Tokens.Item(2).ParameterIndex == FormatToken::NamedParameter);
+		PARGON_CHECK(Equals(format.Tokens.Item(2).ParameterName, "unknown"));
+	}
+
+	void TestMixed()
+	{
+		// indexed tokens are left alone and can refer to the same arguments as the names
+
+		auto format = ParseFormatString("{1} {b|x} {a} {0}");
+
+		PARGON_CHECK(BindFormat(format, Names("a", "b")));
+		PARGON_CHECK(format.Tokens.Item(0).ParameterIndex == 1);
+		PARGON_CHECK(format.Tokens.Item(2).ParameterIndex == 1);
+		PARGON_CHECK(format.Tokens.Item(4).ParameterIndex == 0);
+		PARGON_CHECK(format.Tokens.Item(6).ParameterIndex == 0);
+
+		StringWriter writer;
+		writer.Format(format, 7, 255);
+		PARGON_CHECK(Equals(writer.GetString(), "255 ff 7 7"));
+
+		// binding a second time changes nothing since no named tokens are left
+
+		PARGON_CHECK(BindFormat(format, Names("x", "y")));
+		PARGON_CHECK(format.Tokens.Item(2).ParameterIndex == 1);
+	}
+}
+
+int main()
+{
+	TestBound();
+	TestMissingName();
+	TestMixed();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,110 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/CharacterSet.h"
+#include "Check.h"
+
+#include <random>
+#include <string>
+
+using namespace Pargon;
+
+namespace
+{
+	auto Same(const std::string& text, int begin, int length, const CharacterSet& set, const std::string& characters) -> bool
+	{
+		// the set lookups must agree with the plain character list searches on any slice of the text
+
+		StringView view = { text.data() + begin, length };
+		StringView list = { characters.data(), static_cast<int>(characters.size()) };
+
+		return IndexOfAny(view, set) == IndexOfAny(view, list)
+			&& IndexOfAnyOther(view, set) == IndexOfAnyOther(view, list)
+			&& LastIndexOfAny(view, set) == LastIndexOfAny(view, list)
+			&& LastIndexOfAnyOther(view, set) == LastIndexOfAnyOther(view, list);
+	}
+
+	void TestContains()
+	{
+		// every byte value, including those at or above 0x80, lands in its own bit
+
+		for (auto member = 0; member < 256; member++)
+		{
+			CharacterSet set;
+			set.Add(static_cast<char>(member));
+
+			auto only = true;
+			for (auto other = 0; other < 256; other++)
+				only = only && set.Contains(static_cast<char>(other)) == (other == member);
+
+			PARGON_CHECK(only);
+		}
+	}
+
+	void TestIgnoreCase()
+	{
+		CharacterSet set("aZ!", true);
+
+		PARGON_CHECK(set.Contains('a') && set.Contains('A') && set.Contains('z') && set.Contains('Z') && set.Contains('!'));
+		PARGON_CHECK(!set.Contains('b') && !set.Contains('B') && !set.Contains('1'));
+
+		std::string text = "the quick brown fox jumps over the lazy dog and THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG!";
+
+		for (auto length = 0; length <= static_cast<int>(text.size()); length++)
+			PARGON_CHECK(Same(text, 0, length, set, "aAzZ!"));
+	}
+
+	void TestRandom()
+	{
+		// short slices and odd offsets exercise the scalar tails on either side of the 16 and 32 byte blocks
+
+		std::mt19937 random(11);
+
+		for (auto round = 0; round < 2000; round++)
+		{
+			std::string characters;
+			auto count = static_cast<int>(random() % 8) + 1;
+
+			for (auto i = 0; i < count; i++)
+				characters += static_cast<char>(random() % 256);
+
+			CharacterSet set(StringView{ characters.data(), count }, false);
+
+			std::string text;
+			auto length = static_cast<int>(random() % 100);
+			auto density = static_cast<int>(random() % 40) + 1;
+
+			for (auto i = 0; i < length; i++)
+				text += random() % density == 0 ? characters[random() % count] : static_cast<char>(random() % 256);
+
+			for (auto begin = 0; begin < 4 && begin <= length; begin++)
+			{
+				for (auto slice = 0; begin + slice <= length; slice++)
+					PARGON_CHECK(Same(text, begin, slice, set, characters));
+			}
+		}
+
+		// a set of every character or of none has no other character to find
+
+		std::string all;
+		CharacterSet full;
+
+		for (auto i = 0; i < 256; i++)
+		{
+			all += static_cast<char>(i);
+			full.Add(static_cast<char>(i));
+		}
+
+		PARGON_CHECK(IndexOfAnyOther({ all.data(), 256 }, full) == String::InvalidIndex);
+		PARGON_CHECK(LastIndexOfAny({ all.data(), 256 }, full) == 255);
+		PARGON_CHECK(IndexOfAny({ all.data(), 256 }, CharacterSet()) == String::InvalidIndex);
+		PARGON_CHECK(LastIndexOfAnyOther({ all.data(), 256 }, CharacterSet()) == 255);
+	}
+}
+
+int main()
+{
+	TestContains();
+	TestIgnoreCase();
+	TestRandom();
+
+	return PargonTests::Failures;
+}
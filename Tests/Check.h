@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdio>
+
+// each test is a plain executable that returns the number of failed checks so it can run under ctest without a
+// test framework dependency
+
+namespace PargonTests
+{
+	inline int Failures = 0;
+
+	inline void Check(bool passed, const char* expression, const char* file, int line)
+	{
+		if (!passed)
+		{
+			std::printf("%s(%d): check failed: %s\n", file, line, expression);
+			Failures++;
+		}
+	}
+}
+
+#define PARGON_CHECK(expression) PargonTests::Check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
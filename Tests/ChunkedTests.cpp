@@ -0,0 +1,178 @@
+#include "Pargon/Containers/List.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Check.h"
+
+#include <cstring>
+
+using namespace Pargon;
+
+namespace
+{
+	struct Entity
+	{
+		int Id;
+		float Weight;
+	};
+
+	struct Flags
+	{
+		bool Visible;
+		bool Active;
+		bool Selected;
+
+		void ToBuffer(BufferWriter& writer) const
+		{
+			writer.WriteBit(Visible);
+			writer.WriteBit(Active);
+			writer.WriteBit(Selected);
+		}
+
+		void FromBuffer(BufferReader& reader)
+		{
+			Visible = reader.ReadBit();
+			Active = reader.ReadBit();
+			Selected = reader.ReadBit();
+		}
+	};
+
+	auto Encode(const List<Flags>& flags, int workers, int chunkSize) -> Buffer
+	{
+		WorkPool pool(workers);
+		BufferWriter writer;
+		writer.WriteChunked(flags, pool, chunkSize);
+		return writer.ExtractBuffer();
+	}
+
+	void TestRoundTrip()
+	{
+		WorkPool pool(4);
+
+		for (auto chunkSize : { 1, 7, 64, 1000, 5000 })
+		{
+			List<Entity> entities;
+			for (auto i = 0; i < 1000; i++)
+				entities.Add({ i, i * 0.5f });
+
+			BufferWriter writer;
+			writer.Write(7);
+			writer.WriteChunked(entities, pool, chunkSize);
+			writer.Write(9);
+
+			BufferReader reader(writer.GetBuffer());
+			List<Entity> result;
+
+			PARGON_CHECK(reader.Read<int>() == 7);
+			PARGON_CHECK(reader.ReadChunked(result, pool));
+			PARGON_CHECK(reader.Read<int>() == 9);
+			PARGON_CHECK(reader.AtEnd());
+			PARGON_CHECK(result.Count() == entities.Count());
+
+			for (auto i = 0; i < result.Count() && i < entities.Count(); i++)
+				PARGON_CHECK(result.Item(i).Id == entities.Item(i).Id && result.Item(i).Weight == entities.Item(i).Weight);
+		}
+
+		List<Entity> empty, result;
+		BufferWriter writer;
+		writer.WriteChunked(empty, pool, 16);
+
+		BufferReader reader(writer.GetBuffer());
+		PARGON_CHECK(reader.ReadChunked(result, pool));
+		PARGON_CHECK(result.IsEmpty());
+	}
+
+	void TestBits()
+	{
+		// chunks that end partway through a byte must not depend on which worker wrote them
+
+		List<Flags> flags;
+		for (auto i = 0; i < 999; i++)
+			flags.Add({ i % 2 == 0, i % 3 == 0, i % 5 == 0 });
+
+		auto single = Encode(flags, 1, 5);
+		auto several = Encode(flags, 4, 5);
+
+		PARGON_CHECK(single.Size() == several.Size() && std::memcmp(single.begin(), several.begin(), single.Size()) == 0);
+
+		WorkPool pool(3);
+		BufferReader reader(several);
+		List<Flags> result;
+
+		PARGON_CHECK(reader.ReadChunked(result, pool));
+		PARGON_CHECK(result.Count() == flags.Count());
+
+		for (auto i = 0; i < result.Count() && i < flags.Count(); i++)
+			PARGON_CHECK(result.Item(i).Visible == flags.Item(i).Visible && result.Item(i).Active == flags.Item(i).Active && result.Item(i).Selected == flags.Item(i).Selected);
+	}
+
+	void TestTruncated()
+	{
+		WorkPool pool(2);
+
+		List<Entity> entities;
+		for (auto i = 0; i < 100; i++)
+			entities.Add({ i, 1.0f });
+
+		BufferWriter writer;
+		writer.WriteChunked(entities, pool, 8);
+		auto buffer = writer.GetBuffer();
+
+		for (auto length = 0; length < buffer.Size(); length++)
+		{
+			BufferReader reader({ buffer.begin(), length });
+			List<Entity> result;
+
+			PARGON_CHECK(!reader.ReadChunked(result, pool));
+			PARGON_CHECK(result.IsEmpty());
+		}
+	}
+
+	auto Header(int count, int chunkSize, int chunkCount, int offsetCount) -> Buffer
+	{
+		BufferWriter writer;
+		writer.Write(12 + offsetCount * 4);
+		writer.Write(count);
+		writer.Write(chunkSize);
+		writer.Write(chunkCount);
+
+		for (auto i = 0; i < offsetCount; i++)
+			writer.Write(0);
+
+		return writer.ExtractBuffer();
+	}
+
+	void TestHostileHeaders()
+	{
+		// each of these would allocate gigabytes if the header was trusted
+
+		WorkPool pool(2);
+		Buffer headers[] =
+		{
+			Header(100000000, 1, 100000000, 1),
+			Header(2147483647, 2, 1073741824, 1),
+			Header(2147483647, 2147483647, 1, 2),
+			Header(-1, 1, 0, 1),
+			Header(10, 0, 10, 1),
+		};
+
+		for (auto& header : headers)
+		{
+			BufferReader reader(header);
+			List<Entity> result;
+
+			PARGON_CHECK(!reader.ReadChunked(result, pool));
+			PARGON_CHECK(reader.HasFailed());
+			PARGON_CHECK(result.IsEmpty());
+		}
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestBits();
+	TestTruncated();
+	TestHostileHeaders();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,123 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/DeferredLog.h"
+#include "Pargon/Serialization/FormatCache.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	auto ToString(StringView text) -> std::string
+	{
+		return std::string(text.begin(), text.Length());
+	}
+
+	void TestMatchesFormatString()
+	{
+		static const char format[] = "{} of {|x} in {}";
+
+		std::vector<std::string> lines;
+		DeferredLog log([&](StringView line) { lines.push_back(ToString(line)); }, 4096);
+
+		PARGON_CHECK(log.Log(format, 3, 255, "name"));
+		PARGON_CHECK(log.Log(PARGON_STATIC_FORMAT("{} of {|x} in {}"), 3, 255, "name"));
+		PARGON_CHECK(log.Log(*FormatCache::Find(format), 3, 255, "name"));
+		log.Flush();
+
+		auto expected = ToString(FormatString(format, 3, 255, "name"));
+
+		PARGON_CHECK(lines.size() == 3);
+		for (auto& line : lines)
+			PARGON_CHECK(line == expected);
+	}
+
+	void TestLongLine()
+	{
+		// lines formatted from a runtime format are not limited to any fixed length
+
+		std::string text(1000, 'a');
+		std::string line;
+
+		DeferredLog log([&](StringView output) { line = ToString(output); }, 8192);
+		PARGON_CHECK(log.Log("{} {} {}", StringView(text.c_str()), 7, StringView(text.c_str())));
+		log.Flush();
+
+		PARGON_CHECK(line == text + " 7 " + text);
+	}
+
+	void TestIdleWake()
+	{
+		// a record logged after the background thread has gone idle is written without waiting on Flush
+
+		std::atomic<int> count{ 0 };
+		DeferredLog log([&](StringView) { count++; }, 4096);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		log.Log("{}", 1);
+
+		for (auto i = 0; i < 1000 && count.load() == 0; i++)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		PARGON_CHECK(count.load() == 1);
+	}
+
+	void TestDropped()
+	{
+		// a full ring drops records instead of blocking the logging thread and every kept record is still written
+
+		std::vector<std::string> lines;
+		auto logged = 0;
+
+		{
+			DeferredLog log([&](StringView line) { std::this_thread::sleep_for(std::chrono::microseconds(50)); lines.push_back(ToString(line)); }, 256);
+
+			for (auto i = 0; i < 1000; i++)
+			{
+				if (log.Log("entry {}", i))
+					logged++;
+			}
+
+			log.Flush();
+			PARGON_CHECK(log.Dropped() == 1000 - logged);
+			PARGON_CHECK(log.Dropped() > 0);
+		}
+
+		PARGON_CHECK(static_cast<int>(lines.size()) == logged);
+
+		for (auto& line : lines)
+			PARGON_CHECK(line.rfind("entry ", 0) == 0);
+	}
+
+	void TestDrainOnDestroy()
+	{
+		std::vector<std::string> lines;
+
+		{
+			DeferredLog log([&](StringView line) { lines.push_back(ToString(line)); }, 65536);
+
+			for (auto i = 0; i < 100; i++)
+				log.Log(PARGON_STATIC_FORMAT("{} {}"), i, "done");
+		}
+
+		PARGON_CHECK(lines.size() == 100);
+		PARGON_CHECK(!lines.empty() && lines.back() == "99 done");
+	}
+}
+
+int main()
+{
+	TestMatchesFormatString();
+	TestLongLine();
+	TestIdleWake();
+	TestDropped();
+	TestDrainOnDestroy();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,114 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/FormatCache.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	void TestHitsAndMisses()
+	{
+		static const char format[] = "{} of {}";
+		char copy[] = "{} of {}";
+
+		auto misses = FormatCache::Misses();
+		auto first = FormatCache::Find(format);
+
+		PARGON_CHECK(first != nullptr);
+		PARGON_CHECK(FormatCache::Misses() == misses + 1);
+
+		auto hits = FormatCache::Hits();
+		PARGON_CHECK(FormatCache::Find(format) == first);
+		PARGON_CHECK(FormatCache::Hits() == hits + 1);
+
+		// the same text at a different address is a separate entry
+
+		auto other = FormatCache::Find(StringView(copy));
+		PARGON_CHECK(other != nullptr && other != first);
+
+		// the cached tokens format exactly like a freshly parsed format
+
+		StringWriter cached, parsed;
+		cached.Format(*first, 3, 7);
+		parsed.Format(format, 3, 7);
+		PARGON_CHECK(Equals(cached.GetString(), parsed.GetString()));
+		PARGON_CHECK(Equals(cached.GetString(), "3 of 7"));
+	}
+
+	void TestFormatDoesNotCache()
+	{
+		auto count = FormatCache::Count();
+
+		for (auto i = 0; i < 100; i++)
+		{
+			auto format = std::string("{} ") + std::to_string(i);
+			FormatString(StringView(format.c_str()), i);
+		}
+
+		PARGON_CHECK(FormatCache::Count() == count);
+	}
+
+	void TestConcurrent()
+	{
+		static const char* formats[] = { "a {} b", "{}-{}", "x{|#}y", "{1}{0}" };
+		const StringFormat* results[8][4] = {};
+		std::vector<std::thread> threads;
+
+		for (auto thread = 0; thread < 8; thread++)
+		{
+			threads.emplace_back([&results, thread]
+			{
+				for (auto i = 0; i < 10000; i++)
+					results[thread][i % 4] = FormatCache::Find(formats[i % 4]);
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		for (auto thread = 0; thread < 8; thread++)
+		{
+			for (auto format = 0; format < 4; format++)
+				PARGON_CHECK(results[thread][format] != nullptr && results[thread][format] == results[0][format]);
+		}
+	}
+
+	void TestFull()
+	{
+		// once full new formats are refused but existing entries keep being found
+
+		static const char kept[] = "kept {}";
+		auto entry = FormatCache::Find(kept);
+
+		std::vector<std::string> formats;
+		for (auto i = 0; i < FormatCache::Capacity + 100; i++)
+			formats.push_back("format {} " + std::to_string(i));
+
+		auto refused = 0;
+		for (auto& format : formats)
+		{
+			if (FormatCache::Find(StringView(format.c_str())) == nullptr)
+				refused++;
+		}
+
+		PARGON_CHECK(FormatCache::Count() == FormatCache::Capacity);
+		PARGON_CHECK(refused >= 100);
+		PARGON_CHECK(FormatCache::Find(kept) == entry);
+		PARGON_CHECK(FormatCache::Find(StringView(formats.back().c_str())) == nullptr);
+	}
+}
+
+int main()
+{
+	TestHitsAndMisses();
+	TestFormatDoesNotCache();
+	TestConcurrent();
+	TestFull();
+
+	return PargonTests::Failures;
+}
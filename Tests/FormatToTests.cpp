@@ -0,0 +1,90 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StaticFormat.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace Pargon;
+
+namespace
+{
+	int Allocations = 0;
+}
+
+auto operator new(std::size_t size) -> void*
+{
+	Allocations++;
+
+	if (auto memory = std::malloc(size == 0 ? 1 : size))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+namespace
+{
+	void TestSizeQuery()
+	{
+		// the snprintf style size query counts without writing or allocating
+
+		auto allocations = Allocations;
+		auto size = FormatTo(nullptr, 0, "{} and {|x}", 1234, 255);
+
+		PARGON_CHECK(Allocations == allocations);
+		PARGON_CHECK(size == 11);
+
+		char buffer[16];
+		PARGON_CHECK(FormatTo(buffer, sizeof(buffer), "{} and {|x}", 1234, 255) == size);
+		PARGON_CHECK(std::strcmp(buffer, "1234 and ff") == 0);
+	}
+
+	void TestNoAllocation()
+	{
+		char buffer[8];
+		auto allocations = Allocations;
+
+		auto runtime = FormatTo(buffer, sizeof(buffer), "{} + {}", 1234, 5678);
+		PARGON_CHECK(runtime == 11 && std::strcmp(buffer, "1234 + ") == 0);
+
+		auto compiled = FormatTo(buffer, sizeof(buffer), PARGON_STATIC_FORMAT("{}!"), 42);
+		PARGON_CHECK(compiled == 3 && std::strcmp(buffer, "42!") == 0);
+
+		auto named = 7;
+		auto withName = FormatTo(buffer, sizeof(buffer), "n={n}", NamedArgument("n", named));
+		PARGON_CHECK(withName == 3 && std::strcmp(buffer, "n=7") == 0);
+
+		PARGON_CHECK(FormatTo(buffer, 1, "abc") == 3 && buffer[0] == '\0');
+		PARGON_CHECK(Allocations == allocations);
+	}
+
+	void TestUtf8Boundary()
+	{
+		char buffer[6];
+		auto size = FormatTo(buffer, sizeof(buffer), "ab{}", StringView("\xC3\xA9\xC3\xA9"));
+
+		PARGON_CHECK(size == 6);
+		PARGON_CHECK(std::strcmp(buffer, "ab\xC3\xA9") == 0);
+	}
+}
+
+int main()
+{
+	TestSizeQuery();
+	TestNoAllocation();
+	TestUtf8Boundary();
+
+	return PargonTests::Failures;
+}
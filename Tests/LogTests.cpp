@@ -0,0 +1,198 @@
+#include "Pargon/Serialization/LogReader.h"
+#include "Pargon/Serialization/LogWriter.h"
+#include "Check.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	// block layout from Source/Core/LogFormat.h
+
+	constexpr int HeaderSize = 28;
+	constexpr int ChecksummedOffset = 12;
+	constexpr int RecordCountOffset = 16;
+
+	struct Flags
+	{
+		bool Visible;
+		bool Active;
+		bool Selected;
+
+		void ToBuffer(BufferWriter& writer) const
+		{
+			writer.WriteBit(Visible);
+			writer.WriteBit(Active);
+			writer.WriteBit(Selected);
+		}
+
+		void FromBuffer(BufferReader& reader)
+		{
+			Visible = reader.ReadBit();
+			Active = reader.ReadBit();
+			Selected = reader.ReadBit();
+		}
+	};
+
+	auto Crc32c(const uint8_t* data, int size) -> uint32_t
+	{
+		auto crc = 0xFFFFFFFFu;
+
+		for (auto i = 0; i < size; i++)
+		{
+			crc ^= data[i];
+
+			for (auto bit = 0; bit < 8; bit++)
+				crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+		}
+
+		return ~crc;
+	}
+
+	auto WriteLog(int records, int blockSize, std::vector<int>& blocks) -> std::vector<uint8_t>
+	{
+		std::vector<uint8_t> log;
+
+		{
+			LogWriter writer([&](BufferView block)
+			{
+				blocks.push_back(static_cast<int>(log.size()));
+				log.insert(log.end(), block.begin(), block.end());
+			}, blockSize);
+
+			for (auto i = 0; i < records; i++)
+				writer.Append(i);
+		}
+
+		return log;
+	}
+
+	auto ReadAll(const std::vector<uint8_t>& log, std::vector<int>& values) -> LogReader
+	{
+		// Read stops at a damaged block and resumes at the next one on the following call
+
+		LogReader reader({ log.data(), static_cast<int>(log.size()) });
+
+		for (auto attempt = 0; attempt < 1000; attempt++)
+		{
+			int value;
+			while (reader.Read(value))
+			{
+				PARGON_CHECK(value == reader.RecordNumber() - 1);
+				values.push_back(value);
+			}
+		}
+
+		return reader;
+	}
+
+	void TestRoundTrip()
+	{
+		std::vector<int> blocks, values;
+		auto log = WriteLog(1000, 256, blocks);
+		auto reader = ReadAll(log, values);
+
+		PARGON_CHECK(blocks.size() > 1);
+		PARGON_CHECK(values.size() == 1000);
+		PARGON_CHECK(reader.SkippedBytes() == 0);
+	}
+
+	void TestCorruptAndTruncated()
+	{
+		// a flipped byte loses only its own block and a torn tail loses only the last block
+
+		std::vector<int> blocks, values;
+		auto log = WriteLog(1000, 256, blocks);
+
+		auto records = [&](int block)
+		{
+			auto end = block + 1 < static_cast<int>(blocks.size()) ? blocks[block + 1] : static_cast<int>(log.size());
+			return (end - blocks[block] - HeaderSize) / 8;
+		};
+
+		auto lost = records(2) + records(static_cast<int>(blocks.size()) - 1);
+
+		log[blocks[2] + HeaderSize + 5] ^= 0xFF;
+		log.resize(log.size() - 10);
+
+		auto reader = ReadAll(log, values);
+
+		PARGON_CHECK(static_cast<int>(values.size()) == 1000 - lost);
+		PARGON_CHECK(reader.SkippedBytes() > 0);
+	}
+
+	void TestRecordOverrun()
+	{
+		// a block that checksums but claims more records than it holds must not stall the reader
+
+		std::vector<int> blocks, values;
+		auto log = WriteLog(100, 128, blocks);
+
+		auto block = log.data() + blocks[0];
+		int recordCount;
+		std::memcpy(&recordCount, block + RecordCountOffset, sizeof(recordCount));
+		recordCount += 3;
+		std::memcpy(block + RecordCountOffset, &recordCount, sizeof(recordCount));
+
+		int payloadSize;
+		std::memcpy(&payloadSize, block + 12, sizeof(payloadSize));
+		auto crc = Crc32c(block + ChecksummedOffset, HeaderSize - ChecksummedOffset + payloadSize);
+		std::memcpy(block + 8, &crc, sizeof(crc));
+
+		ReadAll(log, values);
+
+		PARGON_CHECK(values.size() == 100);
+		PARGON_CHECK(!values.empty() && values.back() == 99);
+	}
+
+	void TestBitPacked()
+	{
+		// consecutive records that end mid-byte each keep their own bits
+
+		std::vector<uint8_t> log;
+
+		{
+			LogWriter writer([&](BufferView block) { log.insert(log.end(), block.begin(), block.end()); }, 256);
+			writer.Append(Flags{ true, false, true });
+			writer.Append(Flags{ false, true, true });
+			writer.Append(Flags{ true, true, false });
+		}
+
+		LogReader reader({ log.data(), static_cast<int>(log.size()) });
+		Flags first = {}, second = {}, third = {};
+
+		PARGON_CHECK(reader.Read(first) && first.Visible && !first.Active && first.Selected);
+		PARGON_CHECK(reader.Read(second) && !second.Visible && second.Active && second.Selected);
+		PARGON_CHECK(reader.Read(third) && third.Visible && third.Active && !third.Selected);
+	}
+
+	void TestSeek()
+	{
+		std::vector<int> blocks;
+		auto log = WriteLog(1000, 256, blocks);
+		LogReader reader({ log.data(), static_cast<int>(log.size()) });
+
+		for (auto record : { 700, 5, 0, 999 })
+		{
+			int value = -1;
+			PARGON_CHECK(reader.Seek(record));
+			PARGON_CHECK(reader.Read(value) && value == record);
+		}
+
+		PARGON_CHECK(!reader.Seek(5000));
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestCorruptAndTruncated();
+	TestRecordOverrun();
+	TestBitPacked();
+	TestSeek();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,137 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace Pargon;
+
+namespace
+{
+	auto Matches(const String& result, const char* expected) -> bool
+	{
+		auto length = static_cast<int>(std::strlen(expected));
+		auto matches = result.Length() == length && std::memcmp(result.begin(), expected, length) == 0;
+
+		if (!matches)
+			std::printf("'%.*s' should be '%s'\n", result.Length(), result.begin(), expected);
+
+		return matches;
+	}
+
+	auto MatchesPrintf(double value, const char* specification) -> bool
+	{
+		// the specification uses the same flags as printf so the printf format is just the specification after a '%'
+
+		char format[32];
+		char expected[1024];
+
+		std::snprintf(format, sizeof(format), "%%%s", specification);
+		std::snprintf(expected, sizeof(expected), format, value);
+
+		return Matches(WriteToString(value, StringView(specification)), expected);
+	}
+
+	void TestRounding()
+	{
+		// ties round to even on the exact binary value and carries ripple into a new leading digit
+
+		PARGON_CHECK(MatchesPrintf(0.125, ".2f"));
+		PARGON_CHECK(MatchesPrintf(0.375, ".2f"));
+		PARGON_CHECK(MatchesPrintf(2.5, ".0f"));
+		PARGON_CHECK(MatchesPrintf(3.5, ".0f"));
+		PARGON_CHECK(MatchesPrintf(9.995, ".2f"));
+		PARGON_CHECK(MatchesPrintf(9.96, ".1f"));
+		PARGON_CHECK(MatchesPrintf(9.96, ".0e"));
+		PARGON_CHECK(MatchesPrintf(99.5, ".0f"));
+		PARGON_CHECK(MatchesPrintf(0.00095, ".3g"));
+		PARGON_CHECK(MatchesPrintf(999999.5, "g"));
+	}
+
+	void TestExtremes()
+	{
+		PARGON_CHECK(MatchesPrintf(DBL_MAX, ".64f"));
+		PARGON_CHECK(MatchesPrintf(DBL_MAX, ".64e"));
+		PARGON_CHECK(MatchesPrintf(-DBL_MAX, ".17g"));
+		PARGON_CHECK(MatchesPrintf(std::numeric_limits<double>::denorm_min(), ".64e"));
+		PARGON_CHECK(MatchesPrintf(std::numeric_limits<double>::denorm_min(), ".64f"));
+		PARGON_CHECK(MatchesPrintf(DBL_MIN, ".64g"));
+		PARGON_CHECK(MatchesPrintf(0.0, ".3e"));
+		PARGON_CHECK(MatchesPrintf(-0.0, ".3f"));
+	}
+
+	void TestPadding()
+	{
+		PARGON_CHECK(MatchesPrintf(3.14159, "10.3f"));
+		PARGON_CHECK(MatchesPrintf(-3.14159, "010.2f"));
+		PARGON_CHECK(MatchesPrintf(12345.0, "+.1e"));
+		PARGON_CHECK(MatchesPrintf(2.5, " .2f"));
+		PARGON_CHECK(MatchesPrintf(0.0001, "12g"));
+
+		PARGON_CHECK(Matches(FormatString("{|8}|{|<8}|{|^8}|{|*>8}|{|08}|{|+}|{| }", 42, 42, 42, 42, -42, 42, 42), "      42|42      |   42   |******42|-0000042|+42| 42"));
+		PARGON_CHECK(Matches(FormatString("{|-<10.2f}|{|=+10.2f}|{|*^9.1f}", 2.5, -1.5, 2.25), "2.50------|-     1.50|***2.2***"));
+		PARGON_CHECK(Matches(FormatString("{|5}|{|<5}", std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()), "  inf|-inf "));
+	}
+
+	void TestHexadecimal()
+	{
+		// negative numbers are written as a sign and the magnitude rather than as two's complement
+
+		char expected[64];
+
+		auto minimum = std::numeric_limits<long long>::min();
+		std::snprintf(expected, sizeof(expected), "-%llx", static_cast<unsigned long long>(minimum));
+		PARGON_CHECK(Matches(FormatString("{|x}", minimum), expected));
+
+		auto maximum = std::numeric_limits<unsigned long long>::max();
+		std::snprintf(expected, sizeof(expected), "%llX", maximum);
+		PARGON_CHECK(Matches(FormatString("{|X}", maximum), expected));
+
+		PARGON_CHECK(Matches(FormatString("{|x}|{|X}|{|#}|{|#}|{|08x}", 255, 255, 255u, -255, 48879), "ff|FF|FF|-FF|0000beef"));
+	}
+
+	void TestRandom()
+	{
+		std::mt19937_64 random(5);
+		const char* types[] = { "f", "e", "g" };
+
+		for (auto i = 0; i < 20000; i++)
+		{
+			double value;
+
+			switch (random() % 3)
+			{
+				case 0: { auto bits = random(); std::memcpy(&value, &bits, sizeof(value)); break; }
+				case 1: value = static_cast<double>(static_cast<long long>(random() % 2000001) - 1000000) / 1000.0; break;
+				default: value = std::ldexp(static_cast<double>(random() % 1000000), static_cast<int>(random() % 80) - 40); break;
+			}
+
+			auto type = types[random() % 3];
+
+			if (!std::isfinite(value) || (*type == 'f' && std::fabs(value) > 1e30))
+				continue;
+
+			char specification[32];
+			std::snprintf(specification, sizeof(specification), ".%d%s", static_cast<int>(random() % 20), type);
+
+			PARGON_CHECK(MatchesPrintf(value, specification));
+		}
+	}
+}
+
+int main()
+{
+	TestRounding();
+	TestExtremes();
+	TestPadding();
+	TestHexadecimal();
+	TestRandom();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,196 @@
+#include "Pargon/Containers/Blueprint.h"
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Check.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace Pargon;
+
+namespace
+{
+	template<typename T>
+	auto Parse(const char* text, T& value, int& index) -> bool
+	{
+		StringReader reader{ StringView(text) };
+		reader.Read(value, {});
+		index = reader.Index();
+
+		return !reader.HasFailed();
+	}
+
+	auto MatchesStrtod(const char* text) -> bool
+	{
+		// the same bits as strtod, including the sign of zero and nan, and the same number of characters read
+
+		char* end;
+		auto expected = std::strtod(text, &end);
+		auto value = -1.0;
+		auto index = 0;
+
+		auto matches = Parse(text, value, index) && index == end - text && std::memcmp(&value, &expected, sizeof(value)) == 0;
+
+		if (!matches)
+			std::printf("'%s' read %.17g at %d - strtod read %.17g at %d\n", text, value, index, expected, static_cast<int>(end - text));
+
+		return matches;
+	}
+
+	auto MatchesStrtof(const char* text) -> bool
+	{
+		auto expected = std::strtof(text, nullptr);
+		auto value = -1.0f;
+		auto index = 0;
+
+		auto matches = Parse(text, value, index) && std::memcmp(&value, &expected, sizeof(value)) == 0;
+
+		if (!matches)
+			std::printf("'%s' read %.9g - strtof read %.9g\n", text, value, expected);
+
+		return matches;
+	}
+
+	template<typename T>
+	auto Rejects(const char* text) -> bool
+	{
+		T value = {};
+		auto index = -1;
+
+		return !Parse(text, value, index) && index == 0;
+	}
+
+	void TestRationalBoundaries()
+	{
+		// just either side of half the smallest denormal and of halfway between the largest double and 2^1024
+
+		PARGON_CHECK(MatchesStrtod("2.4703282292062327e-324"));
+		PARGON_CHECK(MatchesStrtod("2.4703282292062328e-324"));
+		PARGON_CHECK(MatchesStrtod("4.9406564584124654e-324"));
+		PARGON_CHECK(MatchesStrtod("1.7976931348623157e308"));
+		PARGON_CHECK(MatchesStrtod("1.7976931348623158e308"));
+		PARGON_CHECK(MatchesStrtod("1.7976931348623159e308"));
+		PARGON_CHECK(MatchesStrtod("1e400"));
+		PARGON_CHECK(MatchesStrtod("-1e400"));
+		PARGON_CHECK(MatchesStrtod("1e-400"));
+		PARGON_CHECK(MatchesStrtod("-0.0"));
+		PARGON_CHECK(MatchesStrtod("00012.5000"));
+		PARGON_CHECK(MatchesStrtod(".5"));
+		PARGON_CHECK(MatchesStrtod("5."));
+		PARGON_CHECK(MatchesStrtod("1e"));
+		PARGON_CHECK(MatchesStrtod("1e+"));
+	}
+
+	void TestRationalWords()
+	{
+		PARGON_CHECK(MatchesStrtod("inf"));
+		PARGON_CHECK(MatchesStrtod("-Infinity"));
+		PARGON_CHECK(MatchesStrtod("infinit"));
+		PARGON_CHECK(MatchesStrtod("INF "));
+
+		auto value = 0.0;
+		auto index = 0;
+
+		PARGON_CHECK(Parse("nan", value, index) && std::isnan(value) && index == 3);
+		PARGON_CHECK(Parse("-NaN,", value, index) && std::isnan(value) && std::signbit(value) && index == 4);
+
+		PARGON_CHECK(Rejects<double>("in"));
+		PARGON_CHECK(Rejects<double>("."));
+		PARGON_CHECK(Rejects<double>("-e5"));
+	}
+
+	void TestFloatRounding()
+	{
+		// halfway between 1 and the next float plus a tiny amount rounds up, though the double it is nearest is the
+		// halfway point itself which would round down to even
+
+		PARGON_CHECK(MatchesStrtof("1.00000005960464477539062500000000001"));
+		PARGON_CHECK(MatchesStrtof("1.00000005960464477539062499999999999"));
+		PARGON_CHECK(MatchesStrtof("1.000000059604644775390625"));
+		PARGON_CHECK(MatchesStrtof("3.4028235677973366e38"));
+		PARGON_CHECK(MatchesStrtof("3.4028235677973367e38"));
+		PARGON_CHECK(MatchesStrtof("7.0064923216240854e-46"));
+		PARGON_CHECK(MatchesStrtof("7.0064923216240862e-46"));
+
+		std::mt19937_64 random(3);
+
+		for (auto i = 0; i < 20000; i++)
+		{
+			// values near float halfway points are where narrowing a double goes wrong
+
+			auto bits = static_cast<uint32_t>(random() % 0x7F000000u);
+			float lower;
+			std::memcpy(&lower, &bits, sizeof(lower));
+
+			auto halfway = (static_cast<double>(lower) + static_cast<double>(std::nextafter(lower, 1e38f))) * 0.5;
+
+			char text[64];
+			std::snprintf(text, sizeof(text), "%.*e", static_cast<int>(random() % 25) + 5, halfway);
+
+			PARGON_CHECK(MatchesStrtof(text));
+		}
+	}
+
+	void TestIntegers()
+	{
+		int number = 0;
+		auto index = 0;
+
+		PARGON_CHECK(Parse("0x1F", number, index) && number == 31 && index == 4);
+		PARGON_CHECK(Parse("  +42xyz", number, index) && number == 42 && index == 5);
+		PARGON_CHECK(Parse("0x", number, index) && number == 0 && index == 1);
+
+		unsigned long long large = 0;
+		PARGON_CHECK(Parse("0xFFFFFFFFFFFFFFFF", large, index) && large == std::numeric_limits<unsigned long long>::max());
+		PARGON_CHECK(Parse("18446744073709551615", large, index) && large == std::numeric_limits<unsigned long long>::max());
+
+		long long signedLarge = 0;
+		PARGON_CHECK(Parse("-9223372036854775808", signedLarge, index) && signedLarge == std::numeric_limits<long long>::min());
+
+		// numbers that do not fit fail without moving the reader
+
+		PARGON_CHECK(Rejects<unsigned long long>("0x10000000000000000"));
+		PARGON_CHECK(Rejects<unsigned long long>("18446744073709551616"));
+		PARGON_CHECK(Rejects<long long>("9223372036854775808"));
+		PARGON_CHECK(Rejects<int>("2147483648"));
+		PARGON_CHECK(Rejects<int>("0x80000000"));
+		PARGON_CHECK(Rejects<unsigned>("-1"));
+		PARGON_CHECK(Rejects<unsigned char>("256"));
+		PARGON_CHECK(Rejects<int>("-"));
+	}
+
+	void TestPonValues()
+	{
+		// each value is the last thing in the input so nothing follows it to end the scan
+
+		Blueprint blueprint;
+		auto index = 0;
+
+		PARGON_CHECK(Parse("42", blueprint, index) && blueprint.IsInteger() && blueprint.AsInteger() == 42);
+		PARGON_CHECK(Parse("0x10", blueprint, index) && blueprint.IsInteger() && blueprint.AsInteger() == 16);
+		PARGON_CHECK(Parse("-9223372036854775808", blueprint, index) && blueprint.IsInteger() && blueprint.AsInteger() == std::numeric_limits<long long>::min());
+		PARGON_CHECK(Parse("9223372036854775808", blueprint, index) && blueprint.IsFloatingPoint() && blueprint.AsFloatingPoint() == 9223372036854775808.0);
+		PARGON_CHECK(Parse("1.5", blueprint, index) && blueprint.IsFloatingPoint() && blueprint.AsFloatingPoint() == 1.5);
+		PARGON_CHECK(Parse("1e3", blueprint, index) && blueprint.IsFloatingPoint() && blueprint.AsFloatingPoint() == 1000.0);
+		PARGON_CHECK(Parse("inf", blueprint, index) && blueprint.IsFloatingPoint() && std::isinf(blueprint.AsFloatingPoint()));
+		PARGON_CHECK(Parse("-nan", blueprint, index) && blueprint.IsFloatingPoint() && std::isnan(blueprint.AsFloatingPoint()));
+		PARGON_CHECK(!Parse("1.5x", blueprint, index));
+		PARGON_CHECK(!Parse("abc", blueprint, index));
+	}
+}
+
+int main()
+{
+	TestRationalBoundaries();
+	TestRationalWords();
+	TestFloatRounding();
+	TestIntegers();
+	TestPonValues();
+
+	return PargonTests::Failures;
+}
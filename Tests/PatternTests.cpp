@@ -0,0 +1,111 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/Pattern.h"
+#include "Check.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	void TestLiteralMatchesRegex()
+	{
+		// a literal pattern and a regex matching the same text find the same positions, with or without case
+
+		const char* texts[] = { "", "abc", "xxabcxx", "ABC", "xAbCx", "ab", "zzz", "abcabc", "a\xC3\x80" "bc", "\xC3\xA0" "abc" };
+
+		for (auto ignoreCase : { false, true })
+		{
+			Pattern literal("abc", ignoreCase);
+			Pattern regex("a[b]c", ignoreCase);
+
+			PARGON_CHECK(literal.IsLiteral());
+			PARGON_CHECK(!regex.IsLiteral());
+
+			for (auto text : texts)
+			{
+				PARGON_CHECK(literal.Search(text) == regex.Search(text));
+				PARGON_CHECK(literal.Match(text) == regex.Match(text));
+			}
+		}
+
+		// bytes outside ascii are not folded by either
+
+		Pattern literal("\xC3\xA0", true);
+		Pattern regex("\xC3[\xA0]", true);
+
+		PARGON_CHECK(literal.Search("\xC3\x80") == -1);
+		PARGON_CHECK(regex.Search("\xC3\x80") == -1);
+	}
+
+	void TestIgnoreCase()
+	{
+		PARGON_CHECK(Pattern("Hello", false).Search("say hello") == -1);
+		PARGON_CHECK(Pattern("Hello", true).Search("say hello") == 4);
+		PARGON_CHECK(Pattern("h[aeiou]llo", true).Search("say HELLO") == 4);
+		PARGON_CHECK(Pattern("h[aeiou]llo", false).Search("say HELLO") == -1);
+	}
+
+	void TestMatch()
+	{
+		// Match only finds a match that starts at the beginning of the text and returns its length
+
+		PARGON_CHECK(Pattern("abc", false).Match("abcdef") == 3);
+		PARGON_CHECK(Pattern("abc", false).Match("xabc") == -1);
+		PARGON_CHECK(Pattern("ab+", false).Match("abbbc") == 4);
+		PARGON_CHECK(Pattern("ab+", false).Match("xabbb") == -1);
+		PARGON_CHECK(Pattern("ab+", false).Search("xabbb") == 1);
+		PARGON_CHECK(Pattern("b*", false).Match("ccc") == 0);
+		PARGON_CHECK(Pattern("", false).Match("ccc") == 0);
+		PARGON_CHECK(Pattern("", false).Search("ccc") == 0);
+	}
+
+	void TestCache()
+	{
+		// a cached pattern stays put until CacheCapacity other patterns are compiled on the same thread
+
+		auto& first = Pattern::Cached("first [0-9]+", false);
+		PARGON_CHECK(&Pattern::Cached("first [0-9]+", false) == &first);
+		PARGON_CHECK(&Pattern::Cached("first [0-9]+", true) != &first);
+
+		std::vector<std::string> others;
+		for (auto i = 0; i < Pattern::CacheCapacity; i++)
+			others.push_back("other " + std::to_string(i));
+
+		for (auto i = 0; i < Pattern::CacheCapacity - 2; i++)
+			Pattern::Cached(StringView(others[i].c_str()), false);
+
+		PARGON_CHECK(Equals(first.Text(), "first [0-9]+"));
+		PARGON_CHECK(first.Search("the first 42") == 4);
+		PARGON_CHECK(&Pattern::Cached("first [0-9]+", false) == &first);
+
+		// once evicted the same text is compiled again and still matches the same way
+
+		for (auto& other : others)
+			Pattern::Cached(StringView(other.c_str()), false);
+
+		auto& again = Pattern::Cached("first [0-9]+", false);
+		PARGON_CHECK(Equals(again.Text(), "first [0-9]+"));
+		PARGON_CHECK(again.Search("the first 42") == 4);
+
+		// each thread has its own cache
+
+		const Pattern* other = nullptr;
+		std::thread thread([&] { other = &Pattern::Cached("first [0-9]+", false); });
+		thread.join();
+
+		PARGON_CHECK(other != &again);
+	}
+}
+
+int main()
+{
+	TestLiteralMatchesRegex();
+	TestIgnoreCase();
+	TestMatch();
+	TestCache();
+
+	return PargonTests::Failures;
+}
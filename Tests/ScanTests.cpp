@@ -0,0 +1,183 @@
+#include "Pargon/Containers/Blueprint.h"
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Core/Scan.h"
+#include "Check.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	auto IsEscape(char character) -> bool
+	{
+		return static_cast<unsigned char>(character) < 0x20 || character == '"' || character == '\\';
+	}
+
+	auto FindEscape(const char* begin, const char* end) -> const char*
+	{
+		while (begin != end && !IsEscape(*begin))
+			begin++;
+
+		return begin;
+	}
+
+	auto PlainText(int length) -> std::vector<char>
+	{
+		// printable ascii and bytes at or above 0x80, none of which need escaping
+
+		std::vector<char> text(length);
+
+		for (auto i = 0; i < length; i++)
+			text[i] = static_cast<char>(i % 2 ? 'a' + i % 26 : 0x80 + i % 0x80);
+
+		return text;
+	}
+
+	void TestEscapePositions()
+	{
+		// each special character on its own at every position around the 16 and 32 byte blocks, including the last byte
+
+		const char specials[] = { '"', '\\', '\0', '\n', '\t', 0x01, 0x1F };
+
+		for (auto length = 1; length <= 100; length++)
+		{
+			for (auto special : specials)
+			{
+				for (auto position = 0; position < length; position++)
+				{
+					auto text = PlainText(length);
+					text[position] = special;
+
+					auto begin = text.data();
+					PARGON_CHECK(FindEscapeCharacter(begin, begin + length) == begin + position);
+				}
+			}
+
+			auto text = PlainText(length);
+			PARGON_CHECK(FindEscapeCharacter(text.data(), text.data() + length) == text.data() + length);
+		}
+	}
+
+	void TestEscapeBoundaries()
+	{
+		// bytes just outside the control range are not escaped
+
+		for (auto byte = 0; byte < 256; byte++)
+		{
+			char text[40];
+			for (auto& character : text)
+				character = 'x';
+
+			text[33] = static_cast<char>(byte);
+
+			auto expected = IsEscape(static_cast<char>(byte)) ? text + 33 : text + 40;
+			PARGON_CHECK(FindEscapeCharacter(text, text + 40) == expected);
+		}
+	}
+
+	void TestEscapeRandom()
+	{
+		std::mt19937 random(7);
+
+		for (auto round = 0; round < 5000; round++)
+		{
+			auto length = static_cast<int>(random() % 200);
+			auto density = static_cast<int>(random() % 64) + 1;
+
+			std::vector<char> text(length);
+			for (auto& character : text)
+				character = random() % density == 0 ? static_cast<char>(random() % 0x20) : static_cast<char>(0x20 + random() % 0xE0);
+
+			auto begin = text.data();
+			auto end = begin + length;
+
+			for (auto offset = 0; offset < 3 && offset <= length; offset++)
+				PARGON_CHECK(FindEscapeCharacter(begin + offset, end) == FindEscape(begin + offset, end));
+		}
+	}
+
+	void TestQuotePositions()
+	{
+		// control characters do not stop this scan, only the quote and the backslash do
+
+		for (auto length = 1; length <= 100; length++)
+		{
+			for (auto special : { '"', '\\' })
+			{
+				for (auto position = 0; position < length; position++)
+				{
+					auto text = PlainText(length);
+					text[length - 1 - position / 2] = '\n';
+					text[position] = special;
+
+					auto begin = text.data();
+					PARGON_CHECK(FindQuoteOrBackslash(begin, begin + length) == begin + position);
+				}
+			}
+
+			std::vector<char> controls(length);
+			for (auto i = 0; i < length; i++)
+				controls[i] = static_cast<char>(i % 0x20);
+
+			PARGON_CHECK(FindQuoteOrBackslash(controls.data(), controls.data() + length) == controls.data() + length);
+		}
+	}
+
+	auto ReadString(const std::string& text, std::string& value) -> bool
+	{
+		StringReader reader{ StringView{ text.data(), static_cast<int>(text.size()) } };
+		Blueprint blueprint;
+		reader.Read(blueprint, {});
+
+		if (reader.HasFailed() || !blueprint.IsString())
+			return false;
+
+		auto string = blueprint.AsStringView();
+		value.assign(string.begin(), string.Length());
+
+		return reader.Index() == static_cast<int>(text.size());
+	}
+
+	void TestPonStrings()
+	{
+		std::string value;
+
+		PARGON_CHECK(ReadString("\"plain\"", value) && value == "plain");
+		PARGON_CHECK(ReadString("\"\"", value) && value.empty());
+		PARGON_CHECK(ReadString("\"line\nbreak\ttab\x01\"", value) && value == "line\nbreak\ttab\x01");
+
+		// a backslash as the last byte, or escaping the only quote, leaves the string unterminated
+
+		PARGON_CHECK(!ReadString("\"abc\\", value));
+		PARGON_CHECK(!ReadString("\"abc\\\"", value));
+		PARGON_CHECK(!ReadString("\"abc", value));
+
+		// escaped quotes and backslashes at every position around the block boundaries
+
+		for (auto position = 0; position < 70; position++)
+		{
+			for (auto escape : { "\\\"", "\\\\" })
+			{
+				std::string text = "\"" + std::string(position, 'a') + escape + std::string(70 - position, 'b') + "\"";
+				std::string expected = std::string(position, 'a') + escape[1] + std::string(70 - position, 'b');
+
+				PARGON_CHECK(ReadString(text, value) && value == expected);
+			}
+		}
+	}
+}
+
+int main()
+{
+	TestEscapePositions();
+	TestEscapeBoundaries();
+	TestEscapeRandom();
+	TestQuotePositions();
+	TestPonStrings();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,132 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace Pargon;
+
+namespace
+{
+	template<typename T>
+	auto Writes(T number, const char* expected) -> bool
+	{
+		auto result = WriteToString(number, {});
+		auto length = static_cast<int>(std::strlen(expected));
+		auto matches = result.Length() == length && std::memcmp(result.begin(), expected, length) == 0;
+
+		if (!matches)
+			std::printf("'%.*s' should be '%s'\n", result.Length(), result.begin(), expected);
+
+		return matches;
+	}
+
+	template<typename T>
+	auto RoundTrips(T number) -> bool
+	{
+		// the text reads back as exactly the same bits and uses no more digits than the type needs
+
+		auto text = WriteToString(number, {});
+
+		StringReader reader{ text };
+		T result = {};
+		reader.Read(result, {});
+
+		auto digits = 0;
+		for (auto character : text)
+		{
+			if (character == 'e')
+				break;
+
+			if (character >= '1' && character <= '9')
+				digits++;
+		}
+
+		auto matches = !reader.HasFailed() && reader.AtEnd() && std::memcmp(&result, &number, sizeof(T)) == 0 && digits <= std::numeric_limits<T>::max_digits10;
+
+		if (!matches)
+			std::printf("'%.*s' did not read back as %.17g\n", text.Length(), text.begin(), static_cast<double>(number));
+
+		return matches;
+	}
+
+	void TestDoubles()
+	{
+		PARGON_CHECK(Writes(0.0, "0.0"));
+		PARGON_CHECK(Writes(-0.0, "-0.0"));
+		PARGON_CHECK(Writes(1.0, "1.0"));
+		PARGON_CHECK(Writes(0.1, "0.1"));
+		PARGON_CHECK(Writes(0.3, "0.3"));
+		PARGON_CHECK(Writes(100.0, "100.0"));
+		PARGON_CHECK(Writes(123456.789, "123456.789"));
+		PARGON_CHECK(Writes(1e20, "100000000000000000000.0"));
+		PARGON_CHECK(Writes(1e21, "1.0e21"));
+		PARGON_CHECK(Writes(1e-7, "1.0e-7"));
+		PARGON_CHECK(Writes(std::numeric_limits<double>::denorm_min(), "5.0e-324"));
+		PARGON_CHECK(Writes(DBL_MAX, "1.7976931348623157e308"));
+		PARGON_CHECK(Writes(std::numeric_limits<double>::infinity(), "inf"));
+		PARGON_CHECK(Writes(-std::numeric_limits<double>::infinity(), "-inf"));
+		PARGON_CHECK(Writes(std::numeric_limits<double>::quiet_NaN(), "nan"));
+		PARGON_CHECK(Writes(2.5L, "2.5"));
+	}
+
+	void TestFloats()
+	{
+		// floats get the shortest digits for a float, not the digits of the double they widen to
+
+		PARGON_CHECK(Writes(0.1f, "0.1"));
+		PARGON_CHECK(Writes(1.0f / 3.0f, "0.33333334"));
+		PARGON_CHECK(Writes(16777216.0f, "16777216.0"));
+		PARGON_CHECK(Writes(1e10f, "10000000000.0"));
+		PARGON_CHECK(Writes(3.4e38f, "3.4e38"));
+		PARGON_CHECK(Writes(FLT_MAX, "3.4028235e38"));
+		PARGON_CHECK(Writes(std::numeric_limits<float>::denorm_min(), "1.0e-45"));
+		PARGON_CHECK(Writes(0.0f, "0.0"));
+	}
+
+	void TestRoundTrip()
+	{
+		std::mt19937_64 random(17);
+
+		for (auto i = 0; i < 20000; i++)
+		{
+			auto bits = random();
+
+			double number;
+			std::memcpy(&number, &bits, sizeof(number));
+
+			if (std::isfinite(number))
+				PARGON_CHECK(RoundTrips(number));
+
+			auto singleBits = static_cast<uint32_t>(bits >> 32);
+
+			float single;
+			std::memcpy(&single, &singleBits, sizeof(single));
+
+			if (std::isfinite(single))
+				PARGON_CHECK(RoundTrips(single));
+		}
+
+		for (auto number : { 0.0, -0.0, DBL_MIN, DBL_MAX, std::numeric_limits<double>::denorm_min(), 1e23, 9007199254740993.0 })
+			PARGON_CHECK(RoundTrips(number));
+
+		for (auto single : { FLT_MIN, FLT_MAX, std::numeric_limits<float>::denorm_min(), 8388608.5f, 1e-10f })
+			PARGON_CHECK(RoundTrips(single));
+	}
+}
+
+int main()
+{
+	TestDoubles();
+	TestFloats();
+	TestRoundTrip();
+
+	return PargonTests::Failures;
+}
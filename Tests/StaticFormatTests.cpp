@@ -0,0 +1,64 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StaticFormat.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+using namespace Pargon;
+
+namespace
+{
+	// each static format must produce exactly what the same text produces when parsed at runtime
+
+	template<typename FormatType, typename... Ts>
+	void CheckSame(FormatType format, const Ts&... inputs)
+	{
+		auto fromStatic = FormatString(format, inputs...);
+		auto fromRuntime = FormatString(StringView(FormatType::Text), inputs...);
+
+		PARGON_CHECK(Equals(fromStatic, fromRuntime));
+	}
+
+	void TestMatchesRuntime()
+	{
+		CheckSame(PARGON_STATIC_FORMAT(""));
+		CheckSame(PARGON_STATIC_FORMAT("no parameters"));
+		CheckSame(PARGON_STATIC_FORMAT("a {} b {} c"), 1, 2.5);
+		CheckSame(PARGON_STATIC_FORMAT("{1}-{0}"), 7, 8);
+		CheckSame(PARGON_STATIC_FORMAT("{{escaped}} {}"), 3);
+		CheckSame(PARGON_STATIC_FORMAT("{-|literal} {}"), 4);
+		CheckSame(PARGON_STATIC_FORMAT("{|#} {|x} {|08.3f} {|<10}|"), 255, 255, 3.14159, -12);
+		CheckSame(PARGON_STATIC_FORMAT("{|{nested}}"), 5);
+		CheckSame(PARGON_STATIC_FORMAT("{} {} {}"), "text", 'c', true);
+	}
+
+	void TestParsedTokens()
+	{
+		auto format = PARGON_STATIC_FORMAT("a {1} {} {name|x}");
+		using Format = decltype(format);
+
+		static_assert(Format::Count == 6, "three literals plus the indexed, next and named tokens");
+		static_assert(Format::Format.ParameterCount == 2, "the highest index is 1");
+		static_assert(Format::Format.UsedParameters == 3, "both indexed parameters are used");
+		static_assert(Format::Format.HasNamedParameters, "the last token is named");
+		static_assert(Format::Format.Tokens[1].ParameterIndex == 1, "explicit index");
+		static_assert(Format::Format.Tokens[3].ParameterIndex == 0, "next index starts from zero");
+		static_assert(Format::Format.Tokens[5].ParameterIndex == FormatToken::NamedParameter, "named token");
+		static_assert(Format::Format.Tokens[5].Number.Notation == NumberFormat::NotationType::Hexadecimal, "the number spec is parsed at compile time");
+
+		// the highest index alone would miss that the first parameter is never used
+
+		auto skipped = PARGON_STATIC_FORMAT("{1}");
+		using Skipped = decltype(skipped);
+		static_assert(Skipped::Format.ParameterCount == 2 && Skipped::Format.UsedParameters == 2, "only the second parameter is used");
+
+		PARGON_CHECK(Format::Length == 17);
+	}
+}
+
+int main()
+{
+	TestMatchesRuntime();
+	TestParsedTokens();
+
+	return PargonTests::Failures;
+}
@@ -0,0 +1,109 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Check.h"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	static_assert(std::is_move_constructible<StringWriter>::value && std::is_move_assignable<StringWriter>::value, "writers can be returned and stored by value");
+	static_assert(!std::is_move_constructible<StackStringWriter<16>>::value, "a stack writer cannot leave its own storage");
+
+	auto MakeWriter(int number) -> StringWriter
+	{
+		StringWriter writer;
+		writer.Format("number {}", number);
+		return writer;
+	}
+
+	void TestHeap()
+	{
+		auto writer = MakeWriter(5);
+		PARGON_CHECK(Equals(writer.GetString(), "number 5"));
+
+		StringWriter moved(std::move(writer));
+		PARGON_CHECK(Equals(moved.GetString(), "number 5"));
+		PARGON_CHECK(writer.GetString().Length() == 0);
+
+		// the moved from writer is empty but still usable
+
+		writer.Write("again"_sv);
+		PARGON_CHECK(Equals(writer.GetString(), "again"));
+
+		moved = std::move(writer);
+		PARGON_CHECK(Equals(moved.GetString(), "again"));
+	}
+
+	void TestChunked()
+	{
+		StringWriter writer(8);
+		writer.Write("a longer string than one chunk"_sv);
+
+		std::vector<StringWriter> writers;
+		writers.push_back(std::move(writer));
+		writers.push_back(MakeWriter(7));
+
+		PARGON_CHECK(Equals(writers[0].GetString(), "a longer string than one chunk"));
+		PARGON_CHECK(Equals(writers[1].GetString(), "number 7"));
+		PARGON_CHECK(writer.ChunkCount() == 0);
+	}
+
+	void TestExternal()
+	{
+		char buffer[4];
+		StringWriter writer(buffer, sizeof(buffer));
+		writer.Write("overflowing"_sv);
+
+		auto moved = std::move(writer);
+		PARGON_CHECK(moved.IsTruncated() && moved.RequiredSize() == 11);
+		PARGON_CHECK(Equals(moved.GetString(), "over"));
+		PARGON_CHECK(!writer.IsTruncated());
+	}
+
+	void TestFlushed()
+	{
+		// pending output is flushed exactly once - by the writer it moved to rather than the one it moved from
+
+		std::string first, second;
+
+		{
+			StringWriter target(64, [&](StringView characters) { second.append(characters.begin(), characters.Length()); return true; });
+			target.Write("second "_sv);
+
+			{
+				StringWriter writer(64, [&](StringView characters) { first.append(characters.begin(), characters.Length()); return true; });
+				writer.Write("first"_sv);
+
+				StringWriter moved(std::move(writer));
+				PARGON_CHECK(first.empty());
+
+				// assigning flushes what the target was holding for its own destination first
+
+				target = std::move(moved);
+				PARGON_CHECK(second == "second ");
+				PARGON_CHECK(first.empty());
+			}
+
+			PARGON_CHECK(first.empty());
+			target.Write(" more"_sv);
+		}
+
+		PARGON_CHECK(first == "first more");
+		PARGON_CHECK(second == "second ");
+	}
+}
+
+int main()
+{
+	TestHeap();
+	TestChunked();
+	TestExternal();
+	TestFlushed();
+
+	return PargonTests::Failures;
+}
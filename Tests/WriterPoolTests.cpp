@@ -0,0 +1,63 @@
+#include "Pargon/Containers/String.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Pargon/Serialization/WriterPool.h"
+#include "Check.h"
+
+#include <memory>
+#include <thread>
+
+using namespace Pargon;
+
+namespace
+{
+	void TestReuse()
+	{
+		// a released writer comes back empty but is the same writer
+
+		StringWriter* first = nullptr;
+
+		{
+			auto writer = WriterPool<StringWriter>::Acquire();
+			writer->Write("contents"_sv);
+			first = &*writer;
+		}
+
+		auto writer = WriterPool<StringWriter>::Acquire();
+		PARGON_CHECK(&*writer == first);
+		PARGON_CHECK(writer->GetString().Length() == 0);
+	}
+
+	struct Holder
+	{
+		std::unique_ptr<PooledWriter<StringWriter>> Writer;
+	};
+
+	void TestThreadExit()
+	{
+		// the holder is constructed before the thread's idle list so it is destroyed after it and returns its writer
+		// to a pool that no longer exists
+
+		auto written = false;
+
+		std::thread thread([&]
+		{
+			static thread_local Holder holder;
+
+			holder.Writer = std::make_unique<PooledWriter<StringWriter>>(WriterPool<StringWriter>::Acquire());
+			(*holder.Writer)->Write("late"_sv);
+			written = Equals((*holder.Writer)->GetString(), "late");
+		});
+
+		thread.join();
+
+		PARGON_CHECK(written);
+	}
+}
+
+int main()
+{
+	TestReuse();
+	TestThreadExit();
+
+	return PargonTests::Failures;
+}